@@ -0,0 +1,26 @@
+"""
+Kernel and Orchestration Configuration (Simulation Benchmark)
+
+Defines the kernels and orchestration function used by the a2a3sim
+scheduling benchmark. The same stamp kernel is registered once per core
+type so synthetic graphs can mix AIC and AIV tasks; MIX tasks run the gang
+variant on a whole block.
+"""
+
+from pathlib import Path
+
+_KERNELS_ROOT = Path(__file__).parent
+
+# Orchestration config
+ORCHESTRATION = {
+    "source": str(_KERNELS_ROOT / "orchestration" / "bench_orch.cpp"),
+    "function_name": "build_bench_graph",
+}
+
+# Kernel configs (simulation kernels, compiled with g++)
+# func_id matches the task core type: 0 = AIC, 1 = AIV, 2 = MIX
+KERNELS = [
+    {"func_id": 0, "source": str(_KERNELS_ROOT / "kernel_stamp.cpp"), "core_type": "aic"},
+    {"func_id": 1, "source": str(_KERNELS_ROOT / "kernel_stamp.cpp"), "core_type": "aiv"},
+    {"func_id": 2, "source": str(_KERNELS_ROOT / "kernel_mix_stamp.cpp"), "core_type": "aic"},
+]
@@ -0,0 +1,91 @@
+/**
+ * Gang Completion Stamp Kernel (Simulation, MIX task)
+ *
+ * Implements: stamps[task] = ++counter, on a whole block at once
+ *
+ * A MIX task runs on the AIC (role 0) and both AIVs (roles 1 and 2) of one
+ * block together, shaped like a fused matmul plus epilogue: every role does
+ * its share of the work, the AIVs write the output tile and mark the stamp
+ * with their role bit, and after the gang barrier the AIC stamps the task.
+ * The AIC only stamps if it sees both marks, so a gang whose cores did not
+ * meet at the barrier leaves the task unstamped and fails host validation.
+ */
+
+#include <cstdint>
+
+// Cores of a gang (RUNTIME_MIX_ROLES)
+constexpr uint32_t MIX_ROLES = 3;
+
+// The loader copies only the kernel's .text section, so the barrier cannot
+// call into the runtime or libc: it follows the runtime's protocol inline
+// (add an arrival, wait until the count reaches the next multiple of
+// MIX_ROLES) and yields the host CPU with a raw sched_yield system call,
+// since the simulated cores of a block may share one CPU.
+static inline __attribute__((always_inline)) void yield_cpu() {
+#if defined(__x86_64__)
+    long ret;
+    __asm__ volatile("syscall" : "=a"(ret) : "a"(24L) : "rcx", "r11", "memory");
+#elif defined(__aarch64__)
+    register long x8 __asm__("x8") = 124;
+    register long x0 __asm__("x0") = 0;
+    __asm__ volatile("svc 0" : "+r"(x0) : "r"(x8) : "memory");
+#endif
+}
+
+static inline __attribute__((always_inline)) void gang_barrier(uint32_t* arrived) {
+    uint32_t ticket = __atomic_fetch_add(arrived, 1, __ATOMIC_ACQ_REL);
+    uint32_t target = ticket - ticket % MIX_ROLES + MIX_ROLES;
+    while (static_cast<int32_t>(__atomic_load_n(arrived, __ATOMIC_ACQUIRE) - target) < 0) {
+        yield_cpu();
+    }
+}
+
+/**
+ * Gang completion stamp kernel implementation
+ *
+ * @param args     Same layout as kernel_stamp:
+ *                 args[0] = stamps pointer (int64 per task)
+ *                 args[1] = task index
+ *                 args[2] = counter pointer (int64, shared by all tasks)
+ *                 args[3] = spin iterations per role before stamping
+ *                 args[4] = unused (wall-clock work, single-core tasks only)
+ *                 args[5] = tiles pointer (int64 tile_words per task), optional
+ *                 args[6] = tile_words, 0 for no payload
+ *                 args[7] = number of input tiles n
+ *                 args[8..8+n) = task indices whose tiles are read
+ * @param role     0 = AIC, 1 and 2 = the block's AIVs
+ * @param barrier  The block's gang barrier arrival count
+ */
+extern "C" void kernel_mix_stamp(int64_t* args, int role, uint32_t* barrier) {
+    int64_t* stamps = reinterpret_cast<int64_t*>(args[0]);
+    int64_t task_idx = args[1];
+    int64_t* counter = reinterpret_cast<int64_t*>(args[2]);
+    int64_t spin = args[3];
+
+    for (volatile int64_t i = 0; i < spin; i++) {
+    }
+
+    // Epilogue on the AIVs: each writes every other word of the output tile
+    if (role > 0) {
+        int64_t tile_words = args[6];
+        if (tile_words > 0) {
+            int64_t* tiles = reinterpret_cast<int64_t*>(args[5]);
+            int64_t* out = tiles + task_idx * tile_words;
+            int64_t num_inputs = args[7];
+            for (int64_t w = role - 1; w < tile_words; w += 2) {
+                int64_t acc = task_idx;
+                for (int64_t k = 0; k < num_inputs; k++) {
+                    acc += tiles[args[8 + k] * tile_words + w];
+                }
+                out[w] = acc;
+            }
+        }
+        __atomic_fetch_or(&stamps[task_idx], int64_t{1} << role, __ATOMIC_RELAXED);
+    }
+
+    gang_barrier(barrier);
+
+    if (role == 0 && __atomic_load_n(&stamps[task_idx], __ATOMIC_RELAXED) == ((1 << 1) | (1 << 2))) {
+        stamps[task_idx] = __atomic_add_fetch(counter, 1, __ATOMIC_SEQ_CST);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * Completion Stamp Kernel (Simulation)
+ *
+ * Implements: stamps[task] = ++counter
+ *
+ * Each task records its position in the global execution order so the host
+ * can check that every task ran exactly once and after its predecessors.
+ * An optional spin loop emulates kernel work. An optional wall-clock wait
+ * emulates a core being occupied for a fixed time, which stays meaningful
+ * when the simulated cores share fewer host CPUs. An optional tile payload
+ * makes each task read its producers' output tiles and write its own, so
+ * where a consumer runs relative to its producer shows up in cache misses.
+ */
+
+#include <cstdint>
+
+// The loader copies only the kernel's .text section, so the wall-clock wait
+// cannot call into libc; it issues clock_gettime(CLOCK_MONOTONIC) and
+// sched_yield as raw system calls instead.
+static inline __attribute__((always_inline)) long raw_syscall2(long nr, long a0, long a1) {
+#if defined(__x86_64__)
+    long ret;
+    __asm__ volatile("syscall" : "=a"(ret) : "a"(nr), "D"(a0), "S"(a1) : "rcx", "r11", "memory");
+    return ret;
+#elif defined(__aarch64__)
+    register long x8 __asm__("x8") = nr;
+    register long x0 __asm__("x0") = a0;
+    register long x1 __asm__("x1") = a1;
+    __asm__ volatile("svc 0" : "+r"(x0) : "r"(x8), "r"(x1) : "memory");
+    return x0;
+#else
+    (void)nr;
+    (void)a0;
+    (void)a1;
+    return -1;
+#endif
+}
+
+static inline __attribute__((always_inline)) int64_t monotonic_us() {
+#if defined(__x86_64__)
+    const long nr_clock_gettime = 228;
+#else
+    const long nr_clock_gettime = 113;
+#endif
+    int64_t ts[2] = {0, 0};  // struct timespec {tv_sec, tv_nsec}
+    raw_syscall2(nr_clock_gettime, 1 /* CLOCK_MONOTONIC */, reinterpret_cast<long>(ts));
+    return ts[0] * 1000000 + ts[1] / 1000;
+}
+
+static inline __attribute__((always_inline)) void yield_cpu() {
+#if defined(__x86_64__)
+    raw_syscall2(24, 0, 0);
+#else
+    raw_syscall2(124, 0, 0);
+#endif
+}
+
+/**
+ * Completion stamp kernel implementation
+ *
+ * @param args  Argument array:
+ *              args[0] = stamps pointer (int64 per task)
+ *              args[1] = task index
+ *              args[2] = counter pointer (int64, shared by all tasks)
+ *              args[3] = spin iterations before stamping
+ *              args[4] = wall-clock time to occupy the core, in microseconds
+ *              args[5] = tiles pointer (int64 tile_words per task), optional
+ *              args[6] = tile_words, 0 for no payload
+ *              args[7] = number of input tiles n
+ *              args[8..8+n) = task indices whose tiles are read
+ */
+extern "C" void kernel_stamp(int64_t* args) {
+    int64_t* stamps = reinterpret_cast<int64_t*>(args[0]);
+    int64_t task_idx = args[1];
+    int64_t* counter = reinterpret_cast<int64_t*>(args[2]);
+    int64_t spin = args[3];
+    int64_t work_us = args[4];
+
+    for (volatile int64_t i = 0; i < spin; i++) {
+    }
+
+    if (work_us > 0) {
+        int64_t until = monotonic_us() + work_us;
+        while (monotonic_us() < until) {
+            yield_cpu();
+        }
+    }
+
+    int64_t tile_words = args[6];
+    if (tile_words > 0) {
+        int64_t* tiles = reinterpret_cast<int64_t*>(args[5]);
+        int64_t* out = tiles + task_idx * tile_words;
+        int64_t num_inputs = args[7];
+        for (int64_t w = 0; w < tile_words; w++) {
+            int64_t acc = task_idx;
+            for (int64_t k = 0; k < num_inputs; k++) {
+                acc += tiles[args[8 + k] * tile_words + w];
+            }
+            out[w] = acc;
+        }
+    }
+
+    stamps[task_idx] = __atomic_add_fetch(counter, 1, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,134 @@
+/**
+ * Benchmark Orchestration Function Implementation
+ *
+ * Builds a synthetic task graph whose shape is generated on the host in
+ * Python and passed in as plain arrays, so the same orchestration serves
+ * every benchmark shape.
+ *
+ * This orchestration function:
+ * 1. Receives the edge list and per-task core types as host arrays
+ * 2. Allocates the stamp buffer (one int64 per task plus a shared counter)
+ * 3. Records the stamp buffer for copy-back during finalize
+ * 4. Adds one stamp task per graph node and one successor per edge
+ * 5. Binds every task's stamp and counter pointers to the "stamps" and
+ *    "counter" parameters so a replay can rebind them to a fresh buffer
+ * 6. Selects the ready queue order (critical-path rank or FIFO) and the
+ *    core placement policy
+ *
+ * With a tile payload every task also reads the output tiles of up to
+ * MAX_INPUT_TILES of its predecessors and writes its own tile.
+ */
+
+// Include runtime.h first to get full Runtime class definition
+#include "runtime.h"
+#include <iostream>
+#include <vector>
+
+constexpr int STAMP_ARGS = 8;  // Kernel arguments before the input tile list
+constexpr int MAX_INPUT_TILES = RUNTIME_MAX_ARGS - STAMP_ARGS;
+
+extern "C" {
+
+int build_bench_graph(Runtime* runtime, uint64_t* args, int arg_count) {
+    // Expected args: [host_stamps, stamps_size, num_tasks, host_edges,
+    //                 num_edges, host_core_types, spin, schedule_by_rank, work_us,
+    //                 placement_policy, locality_wait, host_tiles, tile_bytes]
+    if (arg_count < 13) {
+        std::cerr << "build_bench_graph: Expected at least 13 args, got " << arg_count << '\n';
+        return -1;
+    }
+
+    void* host_stamps = reinterpret_cast<void*>(args[0]);
+    size_t stamps_size = static_cast<size_t>(args[1]);
+    int num_tasks = static_cast<int>(args[2]);
+    const int32_t* edges = reinterpret_cast<const int32_t*>(args[3]);  // (from, to) pairs
+    int num_edges = static_cast<int>(args[4]);
+    const int32_t* core_types = reinterpret_cast<const int32_t*>(args[5]);
+    uint64_t spin = args[6];
+    int schedule_by_rank = static_cast<int>(args[7]);
+    uint64_t work_us = args[8];
+    int placement_policy = static_cast<int>(args[9]);
+    int locality_wait = static_cast<int>(args[10]);
+    void* host_tiles = reinterpret_cast<void*>(args[11]);
+    size_t tile_bytes = static_cast<size_t>(args[12]);
+
+    if (stamps_size < (static_cast<size_t>(num_tasks) + 1) * sizeof(int64_t)) {
+        std::cerr << "build_bench_graph: Stamp buffer too small for " << num_tasks << " tasks\n";
+        return -1;
+    }
+
+    std::cout << "\n=== build_bench_graph: Creating Task Runtime ===" << '\n';
+    std::cout << "Tasks: " << num_tasks << ", edges: " << num_edges << ", spin: " << spin << '\n';
+
+    // Stamps for tasks [0, num_tasks), shared counter in the last slot
+    void* dev_stamps = runtime->host_api.device_malloc(stamps_size);
+    if (!dev_stamps) {
+        std::cerr << "Error: Failed to allocate device memory for stamps\n";
+        return -1;
+    }
+    runtime->host_api.copy_to_device(dev_stamps, host_stamps, stamps_size);
+    runtime->record_tensor_pair(host_stamps, dev_stamps, stamps_size);
+
+    int64_t* stamps = reinterpret_cast<int64_t*>(dev_stamps);
+    uint64_t counter = reinterpret_cast<uint64_t>(stamps + num_tasks);
+
+    // Output tile per task, and the predecessors whose tiles each task reads
+    void* dev_tiles = nullptr;
+    std::vector<std::vector<int>> inputs;
+    if (tile_bytes > 0) {
+        size_t tiles_size = tile_bytes * num_tasks;
+        dev_tiles = runtime->host_api.device_malloc(tiles_size);
+        if (!dev_tiles) {
+            std::cerr << "Error: Failed to allocate device memory for tiles\n";
+            runtime->host_api.device_free(dev_stamps);
+            return -1;
+        }
+        runtime->host_api.copy_to_device(dev_tiles, host_tiles, tiles_size);
+        runtime->record_tensor_pair(host_tiles, dev_tiles, tiles_size);
+        inputs.resize(num_tasks);
+        for (int e = 0; e < num_edges; e++) {
+            std::vector<int>& in = inputs[edges[2 * e + 1]];
+            if (static_cast<int>(in.size()) < MAX_INPUT_TILES) {
+                in.push_back(edges[2 * e]);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_tasks; i++) {
+        uint64_t task_args[RUNTIME_MAX_ARGS];
+        int num_inputs = tile_bytes > 0 ? static_cast<int>(inputs[i].size()) : 0;
+        task_args[0] = reinterpret_cast<uint64_t>(stamps);     // stamps
+        task_args[1] = i;                                      // task index
+        task_args[2] = counter;                                // counter
+        task_args[3] = spin;                                   // spin iterations
+        task_args[4] = work_us;                                // wall-clock work
+        task_args[5] = reinterpret_cast<uint64_t>(dev_tiles);  // tiles
+        task_args[6] = tile_bytes / sizeof(int64_t);           // tile words
+        task_args[7] = num_inputs;                             // input tiles
+        for (int k = 0; k < num_inputs; k++) {
+            task_args[STAMP_ARGS + k] = inputs[i][k];
+        }
+        int core_type = core_types[i];
+        int t = runtime->add_task(task_args, STAMP_ARGS + num_inputs, core_type, core_type);
+        if (t != i || runtime->bind_param("stamps", t, 0) != 0 || runtime->bind_param("counter", t, 2) != 0) {
+            std::cerr << "Error: Failed to add task " << i << '\n';
+            runtime->host_api.device_free(dev_stamps);
+            if (dev_tiles) {
+                runtime->host_api.device_free(dev_tiles);
+            }
+            return -1;
+        }
+    }
+
+    for (int e = 0; e < num_edges; e++) {
+        runtime->add_successor(edges[2 * e], edges[2 * e + 1]);
+    }
+    runtime->schedule_by_rank = schedule_by_rank;
+    runtime->placement_policy = placement_policy;
+    runtime->locality_wait = locality_wait;
+
+    std::cout << "Created runtime with " << runtime->get_task_count() << " tasks\n";
+    return 0;
+}
+
+}  // extern "C"
@@ -0,0 +1,445 @@
+#!/usr/bin/env python3
+"""
+A2A3Sim Scheduling Benchmark - Synthetic Task Graphs
+
+Builds large synthetic task graphs on the a2a3sim platform and measures how
+fast the runtime constructs and schedules them. Every task runs the stamp
+kernel, which records the global order in which tasks started; the host
+uses the stamps to check that each task ran exactly once and only after
+all of its predecessors.
+
+Flow:
+1. Python: Generate the graph shape (edge list + per-task core types)
+2. Python: Build the simulation runtime, compile kernels and orchestration
+3. C++ build_bench_graph(): Adds one task per node and one edge per dependency
+4. Python launch_runtime(): Executes the graph with host threads, then
+   optionally replay_runtime() to re-run it without rebuilding, rebinding
+   the stamp buffer through set_runtime_param() before each replay
+5. Python: Validates stamps and reports timings (and cache misses per
+   completed task when hardware counters are available) and the measured
+   per-kernel costs, optionally saved to seed the next run
+
+With --graphs N the example builds N independent copies of the graph, each
+in its own runtime, and runs them concurrently on disjoint core partitions
+of --block-dim blocks each (launch_runtime_async() / wait_runtime()), the
+way a server packs many small independent requests onto one device.
+
+--idle-wait chooses how idle simulated cores and AICPU threads wait
+(set_idle_wait()): spin, yield the host CPU, or block on a futex until
+woken. It matters once simulated cores outnumber host CPUs, e.g.
+    python main.py --tasks 2000 --block-dim 24 --spin 20000 --idle-wait spin
+
+--core-backend fibers runs the simulated cores as fibers on a few host
+threads (set_core_backend()) instead of one thread each, and
+--core-backend direct skips the AICPU/AICore emulation and runs the graph
+straight on --host-threads workers (1 = a fixed task order). With --tile-kb
+the printed tile checksum lets runs on all backends be compared, e.g.
+    python main.py --tasks 5000 --block-dim 48 --tile-kb 1 --core-backend fibers
+    python main.py --tile-kb 1 --core-backend direct --host-threads 1
+
+Example usage:
+    python main.py                          # 100k-task layered graph
+    python main.py --shape random --tasks 20000 --fanin 4
+    python main.py --width 256 --fanin 32   # large fan-in/fan-out
+    python main.py --tasks 500 --graphs 4   # 4 graphs in flight at once
+"""
+
+import sys
+import json
+import hashlib
+import time
+import argparse
+from pathlib import Path
+import numpy as np
+
+# Add parent directory to path so we can import bindings
+example_root = Path(__file__).parent
+runtime_root = Path(__file__).parent.parent.parent
+runtime_dir = runtime_root / "python"
+sys.path.insert(0, str(runtime_dir))
+sys.path.insert(0, str(example_root))
+
+try:
+    from runtime_builder import RuntimeBuilder
+    from bindings import (bind_host_binary, register_kernel, set_device, launch_runtime, replay_runtime,
+                          launch_runtime_async, replay_runtime_async, wait_runtime, set_runtime_param,
+                          get_cost_model, set_cost_model, set_idle_wait, set_core_backend, SCHED_POLICIES,
+                          MAX_PARTITIONS, IDLE_WAIT_MODES, CORE_BACKENDS)
+    from elf_parser import extract_text_section
+    from kernels.kernel_config import KERNELS, ORCHESTRATION
+    from perf_counters import CacheCounters
+except ImportError as e:
+    print(f"Error: Cannot import module: {e}")
+    print("Make sure you are running this from the correct directory")
+    sys.exit(1)
+
+
+def make_layered_graph(num_tasks, width, fanin):
+    """
+    Layers of `width` tasks; each task depends on `fanin` distinct tasks of
+    the previous layer.
+
+    Returns:
+        int32 array of shape (num_edges, 2) holding (from, to) task IDs
+    """
+    fanin = min(fanin, width)
+    stride = max(1, width // max(fanin, 1))
+    to_tasks = np.arange(width, num_tasks, dtype=np.int64)
+    layer_start = (to_tasks // width) * width
+    pos = to_tasks - layer_start
+    edges = []
+    for k in range(fanin):
+        prev_pos = (pos + k * stride) % width
+        from_tasks = layer_start - width + prev_pos
+        edges.append(np.stack([from_tasks, to_tasks], axis=1))
+    if not edges:
+        return np.zeros((0, 2), dtype=np.int32)
+    return np.concatenate(edges).astype(np.int32)
+
+
+def make_random_graph(num_tasks, window, fanin, rng):
+    """
+    Random DAG: each task depends on up to `fanin` distinct tasks among the
+    `window` tasks created just before it.
+
+    Returns:
+        int32 array of shape (num_edges, 2) holding (from, to) task IDs
+    """
+    to_tasks = np.repeat(np.arange(num_tasks, dtype=np.int64), fanin)
+    from_tasks = to_tasks - rng.integers(1, window + 1, size=to_tasks.shape[0])
+    keep = from_tasks >= 0
+    keys = np.unique(from_tasks[keep] * num_tasks + to_tasks[keep])
+    return np.stack([keys // num_tasks, keys % num_tasks], axis=1).astype(np.int32)
+
+
+def make_unbalanced_graph(num_tasks, width):
+    """
+    `width` independent chains with Zipf-distributed lengths: chain c has
+    about 1 / (c + 1) of the tasks. An arrival-order ready queue round-robins
+    between the chains, so the critical chain is left running alone once
+    the short ones finish.
+
+    Returns:
+        int32 array of shape (num_edges, 2) holding (from, to) task IDs
+    """
+    width = max(1, min(width, num_tasks))
+    weights = 1.0 / np.arange(1, width + 1)
+    lengths = np.maximum(1, np.floor(weights / weights.sum() * num_tasks).astype(np.int64))
+    lengths[0] += num_tasks - lengths.sum()
+    starts = np.concatenate([[0], np.cumsum(lengths)[:-1]])
+    chain_start = np.repeat(starts, lengths)
+    to_tasks = np.arange(num_tasks, dtype=np.int64)
+    keep = to_tasks > chain_start
+    to_tasks = to_tasks[keep]
+    return np.stack([to_tasks - 1, to_tasks], axis=1).astype(np.int32)
+
+
+def count_chained(edges, core_types, num_tasks):
+    """
+    Number of tasks that run as a chain successor when chaining is on: a
+    task has one if some successor of the same core type has no other
+    predecessor, and each task chains at most one successor. MIX tasks
+    never chain.
+    """
+    if edges.shape[0] == 0:
+        return 0
+    fanin = np.bincount(edges[:, 1], minlength=num_tasks)
+    chainable = ((fanin[edges[:, 1]] == 1) & (core_types[edges[:, 0]] == core_types[edges[:, 1]])
+                 & (core_types[edges[:, 0]] != 2))
+    return int(np.unique(edges[chainable, 0]).size)
+
+
+def validate_stamps(stamps, edges, num_tasks):
+    """Check every task ran once and after all of its predecessors."""
+    task_stamps = stamps[:num_tasks]
+    if not np.array_equal(np.sort(task_stamps), np.arange(1, num_tasks + 1)):
+        missing = int(np.sum(task_stamps == 0))
+        print(f"FAILED: stamps are not a permutation of 1..{num_tasks} ({missing} tasks never ran)")
+        return False
+    if edges.shape[0] > 0:
+        violated = int(np.sum(task_stamps[edges[:, 0]] >= task_stamps[edges[:, 1]]))
+        if violated > 0:
+            print(f"FAILED: {violated} edges ran out of order")
+            return False
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="A2A3Sim scheduling benchmark")
+    parser.add_argument("-d", "--device", type=int, default=0,
+                        help="Device ID (simulation, default: 0)")
+    parser.add_argument("--tasks", type=int, default=100000,
+                        help="Number of tasks (default: 100000)")
+    parser.add_argument("--shape", choices=["layered", "random", "unbalanced"], default="layered",
+                        help="Graph shape (default: layered)")
+    parser.add_argument("--width", type=int, default=64,
+                        help="Layer width / random dependency window (default: 64)")
+    parser.add_argument("--fanin", type=int, default=2,
+                        help="Predecessors per task (default: 2)")
+    parser.add_argument("--aic-ratio", type=float, default=1.0 / 3,
+                        help="Fraction of tasks placed on AIC cores (default: 1/3)")
+    parser.add_argument("--mix-ratio", type=float, default=0.0,
+                        help="Fraction of tasks gang-scheduled on a whole block as MIX tasks (default: 0)")
+    parser.add_argument("--spin", type=int, default=0,
+                        help="Spin iterations per kernel to emulate work (default: 0)")
+    parser.add_argument("--work-us", type=int, default=0,
+                        help="Wall-clock microseconds each kernel occupies its core (default: 0)")
+    parser.add_argument("--schedule", choices=["rank", "fifo"], default="rank",
+                        help="Ready queue order: critical-path rank or FIFO (default: rank)")
+    parser.add_argument("--mailbox-depth", type=int, default=1,
+                        help="Tasks in flight per core, 1-4 (default: 1)")
+    parser.add_argument("--resolve", choices=["aicpu", "aicore"], default="aicpu",
+                        help="Where successor fanins are resolved (default: aicpu)")
+    parser.add_argument("--chain", choices=["on", "off"], default="on",
+                        help="Run chain successors on the finishing core (default: on)")
+    parser.add_argument("--policy", choices=list(SCHED_POLICIES), default="graph",
+                        help="AICPU scheduling policy; 'graph' uses --schedule and --placement (default: graph)")
+    parser.add_argument("--placement", choices=["any", "locality"], default="any",
+                        help="Core placement: any idle core, or prefer the producer's core/block (default: any)")
+    parser.add_argument("--locality-wait", type=int, default=64,
+                        help="Scheduler rounds a task waits for its producer's block (default: 64)")
+    parser.add_argument("--tile-kb", type=int, default=0,
+                        help="Output tile per task in KiB, read by its successors (default: 0)")
+    parser.add_argument("--threads", type=int, default=3,
+                        help="AICPU scheduler threads (default: 3)")
+    parser.add_argument("--block-dim", type=int, default=3,
+                        help="Blocks, each 1 AIC + 2 AIV; need not be a multiple of --threads (default: 3)")
+    parser.add_argument("--rebalance", choices=["on", "off"], default="off",
+                        help="Move idle blocks between AICPU threads by observed load (default: off)")
+    parser.add_argument("--group-size", type=int, default=0,
+                        help="AICPU threads per coordinator group; 0 = one flat group (default: 0)")
+    parser.add_argument("--seed", type=int, default=0,
+                        help="Random seed (default: 0)")
+    parser.add_argument("--replays", type=int, default=0,
+                        help="Extra executions of the same graph via replay_runtime() (default: 0)")
+    parser.add_argument("--stamps-out", type=str, default=None,
+                        help="Save the first run's start stamps with the edges and core types (.npz)")
+    parser.add_argument("--cost-model", type=str, default=None,
+                        help="JSON file to seed the kernel cost model from (if present) and save it to")
+    parser.add_argument("--graphs", type=int, default=1,
+                        help=f"Copies of the graph run concurrently, each on its own partition of --block-dim "
+                             f"blocks, 1-{MAX_PARTITIONS} (default: 1)")
+    parser.add_argument("--idle-wait", choices=list(IDLE_WAIT_MODES), default="block",
+                        help="How idle simulated cores and AICPU threads wait (default: block)")
+    parser.add_argument("--idle-spin", type=int, default=64,
+                        help="Idle polls that only spin before yielding (default: 64)")
+    parser.add_argument("--idle-yield", type=int, default=64,
+                        help="Yielding idle polls before blocking, block mode (default: 64)")
+    parser.add_argument("--core-backend", choices=list(CORE_BACKENDS), default="threads",
+                        help="Run simulated cores on one thread each or as fibers, or run the graph "
+                             "directly without handshakes (default: threads)")
+    parser.add_argument("--host-threads", type=int, default=0,
+                        help="Host threads of the fiber or direct backend, 0 = one per CPU (default: 0)")
+    args = parser.parse_args()
+    if not 1 <= args.graphs <= MAX_PARTITIONS:
+        parser.error(f"--graphs must be between 1 and {MAX_PARTITIONS}")
+
+    rng = np.random.default_rng(args.seed)
+    num_tasks = args.tasks
+
+    # Generate the graph on the host
+    print(f"\n=== Generating {args.shape} graph ===")
+    if args.shape == "layered":
+        edges = make_layered_graph(num_tasks, args.width, args.fanin)
+    elif args.shape == "random":
+        edges = make_random_graph(num_tasks, args.width, args.fanin, rng)
+    else:
+        edges = make_unbalanced_graph(num_tasks, args.width)
+    edges = np.ascontiguousarray(edges, dtype=np.int32)
+    core_types = (rng.random(num_tasks) >= args.aic_ratio).astype(np.int32)  # 0=AIC, 1=AIV
+    if args.mix_ratio > 0:
+        core_types[rng.random(num_tasks) < args.mix_ratio] = 2  # MIX
+    print(f"Tasks: {num_tasks}, edges: {edges.shape[0]}, "
+          f"AIC tasks: {int(np.sum(core_types == 0))}, AIV tasks: {int(np.sum(core_types == 1))}, "
+          f"MIX tasks: {int(np.sum(core_types == 2))}")
+
+    # Build simulation runtime
+    print("\n=== Building Simulation Runtime ===")
+    builder = RuntimeBuilder(platform="a2a3sim")
+    pto_compiler = builder.get_pto_compiler()
+    try:
+        host_binary, aicpu_binary, aicore_binary = builder.build("host_build_graph")
+    except Exception as e:
+        print(f"Error: Failed to build runtime libraries: {e}")
+        return -1
+
+    Runtime = bind_host_binary(host_binary)
+    set_device(args.device)
+    set_idle_wait(args.idle_wait, args.idle_spin, args.idle_yield)
+    set_core_backend(args.core_backend, args.host_threads)
+
+    # Compile orchestration shared library
+    orch_so_binary = pto_compiler.compile_orchestration(
+        ORCHESTRATION["source"],
+        extra_include_dirs=[
+            str(runtime_root / "src" / "runtime" / "host_build_graph" / "runtime"),  # for runtime.h
+        ] + pto_compiler.get_platform_include_dirs()
+    )
+
+    # Compile and register simulation kernels
+    print("\n=== Compiling and Registering Simulation Kernels ===")
+    for kernel in KERNELS:
+        kernel_o = pto_compiler.compile_incore(
+            kernel["source"],
+            core_type=kernel.get("core_type", "aiv"),
+        )
+        register_kernel(kernel["func_id"], extract_text_section(kernel_o))
+
+    # Seed the cost model before orchestration so the first launch's ranks
+    # already use the measured costs
+    cost_path = Path(args.cost_model) if args.cost_model else None
+    if cost_path is not None and cost_path.exists():
+        seed = json.loads(cost_path.read_text())
+        set_cost_model({int(f): tuple(entry) for f, entry in seed.items()})
+        print(f"Cost model seeded from {cost_path} ({len(seed)} kernels)")
+
+    # One runtime per graph copy, each with its own stamps and tiles
+    tile_bytes = args.tile_kb * 1024
+    runtimes = []
+    tile_buffers = []
+    stamp_runs = []  # Stamp buffers of every run of every graph
+    build_s = 0.0
+    for g in range(args.graphs):
+        # Stamps for every task plus the shared counter in the last slot
+        host_stamps = np.zeros(num_tasks + 1, dtype=np.int64)
+        # Output tile of every task (empty without a payload)
+        host_tiles = np.zeros(max(num_tasks * tile_bytes // 8, 1), dtype=np.int64)
+
+        # Build func_args: [stamps_ptr, stamps_size, num_tasks, edges_ptr, num_edges, core_types_ptr, spin,
+        #                   schedule_by_rank, work_us, placement_policy, locality_wait, tiles_ptr, tile_bytes]
+        func_args = [
+            host_stamps.ctypes.data,
+            host_stamps.nbytes,
+            num_tasks,
+            edges.ctypes.data,
+            edges.shape[0],
+            core_types.ctypes.data,
+            args.spin,
+            1 if args.schedule == "rank" else 0,
+            args.work_us,
+            1 if args.placement == "locality" else 0,
+            args.locality_wait,
+            host_tiles.ctypes.data,
+            tile_bytes,
+        ]
+
+        print(f"\n=== Creating and Initializing Runtime {g} ===")
+        runtime = Runtime()
+        t0 = time.perf_counter()
+        runtime.initialize(orch_so_binary, ORCHESTRATION["function_name"], func_args)
+        build_s += time.perf_counter() - t0
+        runtimes.append(runtime)
+        tile_buffers.append(host_tiles)
+        stamp_runs.append(host_stamps)
+
+    launch_args = dict(aicpu_thread_num=args.threads,
+                       block_dim=args.block_dim,
+                       device_id=args.device,
+                       aicpu_binary=aicpu_binary,
+                       aicore_binary=aicore_binary,
+                       mailbox_depth=args.mailbox_depth,
+                       resolve_on_aicore=args.resolve == "aicore",
+                       chain_successors=args.chain == "on",
+                       sched_policy=args.policy,
+                       rebalance_cores=args.rebalance == "on",
+                       sched_group_size=args.group_size)
+
+    print("\n=== Executing Runtime (Simulation) ===")
+    counters = CacheCounters()
+    counters.start()
+    t0 = time.perf_counter()
+    if args.graphs == 1:
+        launch_runtime(runtimes[0], **launch_args)
+    else:
+        # Graph g runs on partition g, blocks [g * block_dim, (g + 1) * block_dim)
+        for g, runtime in enumerate(runtimes):
+            launch_runtime_async(runtime, partition=g, first_block=g * args.block_dim, **launch_args)
+        for runtime in runtimes:
+            wait_runtime(runtime)
+    launch_s = time.perf_counter() - t0
+    misses = counters.stop()
+    counters.close()
+
+    # Each replay gets a fresh stamp buffer through the "stamps"/"counter"
+    # graph parameters. Simulation device memory is host memory, so a
+    # numpy buffer can be bound directly.
+    replay_times = []
+    for _ in range(args.replays):
+        t0 = time.perf_counter()
+        for runtime in runtimes:
+            stamps = np.zeros(num_tasks + 1, dtype=np.int64)
+            set_runtime_param(runtime, "stamps", stamps.ctypes.data)
+            set_runtime_param(runtime, "counter", stamps.ctypes.data + num_tasks * stamps.itemsize)
+            if args.graphs == 1:
+                replay_runtime(runtime)
+            else:
+                replay_runtime_async(runtime)
+            stamp_runs.append(stamps)
+        if args.graphs > 1:
+            for runtime in runtimes:
+                wait_runtime(runtime)
+        replay_times.append(time.perf_counter() - t0)
+
+    for runtime in runtimes:
+        runtime.finalize()
+
+    print("\n=== Benchmark Results ===")
+    print(f"Graph build: {build_s * 1e3:.1f} ms")
+    if args.policy == "graph":
+        policy = f"{args.schedule} order, {args.placement} placement"
+    else:
+        policy = f"{args.policy} policy"
+    total_tasks = num_tasks * args.graphs
+    if args.graphs > 1:
+        print(f"Partitions:  {args.graphs} graphs in flight, {args.block_dim} blocks and "
+              f"{args.threads} AICPU threads each")
+    print(f"Execution:   {launch_s * 1e3:.1f} ms ({total_tasks / launch_s:.0f} tasks/s, {policy}, "
+          f"mailbox depth {args.mailbox_depth}, resolved on {args.resolve}, {args.idle_wait} idle wait, "
+          f"{args.core_backend} backend)")
+    if tile_bytes > 0:
+        digest = hashlib.sha256()
+        for tiles in tile_buffers:
+            digest.update(tiles.tobytes())
+        print(f"Tile checksum: {digest.hexdigest()[:16]}")
+    # Start order of every run; fixed only on a single direct worker
+    digest = hashlib.sha256()
+    for stamps in stamp_runs:
+        digest.update(stamps.tobytes())
+    print(f"Stamp checksum: {digest.hexdigest()[:16]}")
+    if args.stamps_out is not None:
+        np.savez(args.stamps_out, stamps=stamp_runs[0][:num_tasks], edges=edges, core_types=core_types)
+        print(f"Stamps saved to {args.stamps_out}")
+    if misses is None:
+        print(f"Cache misses: unavailable ({counters.error})")
+    else:
+        for name, count in misses.items():
+            print(f"{name}: {count} ({count / total_tasks:.1f} per completed task)")
+    if replay_times:
+        replay_s = min(replay_times)
+        mean_s = sum(replay_times) / len(replay_times)
+        print(f"Replay:      {replay_s * 1e3:.1f} ms best of {len(replay_times)}, {mean_s * 1e6:.0f} us mean "
+              f"({total_tasks / replay_s:.0f} tasks/s)")
+    chained = count_chained(edges, core_types, num_tasks)
+    if args.chain == "on":
+        print(f"Chained:     {chained} tasks ({100.0 * chained / max(num_tasks, 1):.1f}%) "
+              f"skipped the AICPU dispatch round trip")
+    else:
+        print(f"Chainable:   {chained} tasks (chaining off)")
+    cost_model = get_cost_model()
+    for func_id, (samples, mean, var) in sorted(cost_model.items()):
+        print(f"Cost func {func_id}: {mean / 1e3:.1f} us +/- {var ** 0.5 / 1e3:.1f} us ({samples} tasks measured)")
+    if cost_path is not None:
+        cost_path.write_text(json.dumps({str(f): list(entry) for f, entry in cost_model.items()}, indent=2))
+        print(f"Cost model saved to {cost_path}")
+
+    for stamps in stamp_runs:
+        if not validate_stamps(stamps, edges, num_tasks):
+            return -1
+    runs = f" in each of {1 + args.replays} runs" if args.replays else ""
+    graphs = f" of each of {args.graphs} graphs" if args.graphs > 1 else ""
+    print(f"\nSUCCESS: All {num_tasks} tasks ran once and in dependency order{runs}{graphs}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
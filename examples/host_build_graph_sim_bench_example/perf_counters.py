@@ -0,0 +1,109 @@
+"""
+Hardware cache counters for the simulation benchmark (Linux perf_event_open)
+
+Counters are opened on the calling thread with `inherit` set, so the AICPU
+and AICore threads that the simulator spawns during launch_runtime() are
+counted too; their counts are folded into the parent counter when they are
+joined. Opening fails gracefully on hosts without hardware counters (VMs,
+containers, perf_event_paranoid > 2).
+"""
+
+import ctypes
+import os
+import platform
+import struct
+
+_SYS_PERF_EVENT_OPEN = {"x86_64": 298, "aarch64": 241}
+
+PERF_TYPE_HARDWARE = 0
+PERF_TYPE_HW_CACHE = 3
+PERF_COUNT_HW_CACHE_MISSES = 3
+# L1D | (OP_READ << 8) | (RESULT_MISS << 16)
+PERF_COUNT_HW_CACHE_L1D_READ_MISS = 0 | (0 << 8) | (1 << 16)
+
+_PERF_EVENT_IOC_ENABLE = 0x2400
+_PERF_EVENT_IOC_DISABLE = 0x2401
+_PERF_EVENT_IOC_RESET = 0x2403
+
+# attr flag bits: disabled, inherit, exclude_kernel, exclude_hv
+_ATTR_FLAGS = (1 << 0) | (1 << 1) | (1 << 5) | (1 << 6)
+
+
+class _PerfEventAttr(ctypes.Structure):
+    """struct perf_event_attr, PERF_ATTR_SIZE_VER0 (64 bytes)"""
+    _fields_ = [
+        ("type", ctypes.c_uint32),
+        ("size", ctypes.c_uint32),
+        ("config", ctypes.c_uint64),
+        ("sample_period", ctypes.c_uint64),
+        ("sample_type", ctypes.c_uint64),
+        ("read_format", ctypes.c_uint64),
+        ("flags", ctypes.c_uint64),
+        ("wakeup_events", ctypes.c_uint32),
+        ("bp_type", ctypes.c_uint32),
+        ("config1", ctypes.c_uint64),
+    ]
+
+
+class CacheCounters:
+    """
+    Counts LLC misses and L1D read misses over a region of code.
+
+    Usage:
+        counters = CacheCounters()
+        counters.start()
+        ...
+        results = counters.stop()  # {"cache-misses": n, ...} or None
+    """
+
+    EVENTS = [
+        ("cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+        ("L1-dcache-load-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D_READ_MISS),
+    ]
+
+    def __init__(self):
+        self._fds = {}
+        self.error = None
+        syscall_nr = _SYS_PERF_EVENT_OPEN.get(platform.machine())
+        if syscall_nr is None:
+            self.error = f"perf_event_open not supported on {platform.machine()}"
+            return
+
+        libc = ctypes.CDLL(None, use_errno=True)
+        self._ioctl = libc.ioctl
+        for name, event_type, config in self.EVENTS:
+            attr = _PerfEventAttr()
+            attr.type = event_type
+            attr.size = ctypes.sizeof(_PerfEventAttr)
+            attr.config = config
+            attr.flags = _ATTR_FLAGS
+            fd = libc.syscall(syscall_nr, ctypes.byref(attr), 0, -1, -1, 0)
+            if fd < 0:
+                self.error = f"{name}: {os.strerror(ctypes.get_errno())}"
+                self.close()
+                return
+            self._fds[name] = fd
+
+    @property
+    def available(self):
+        return bool(self._fds)
+
+    def start(self):
+        for fd in self._fds.values():
+            self._ioctl(fd, _PERF_EVENT_IOC_RESET, 0)
+            self._ioctl(fd, _PERF_EVENT_IOC_ENABLE, 0)
+
+    def stop(self):
+        """Stop counting and return {event name: count}, or None if unavailable."""
+        if not self.available:
+            return None
+        results = {}
+        for name, fd in self._fds.items():
+            self._ioctl(fd, _PERF_EVENT_IOC_DISABLE, 0)
+            results[name] = struct.unpack("Q", os.read(fd, 8))[0]
+        return results
+
+    def close(self):
+        for fd in self._fds.values():
+            os.close(fd)
+        self._fds = {}
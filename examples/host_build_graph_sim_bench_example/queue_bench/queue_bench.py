@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Ready Queue Microbenchmark Runner
+
+Compiles ready_queue_bench.cpp against the runtime's lock-free ReadyQueue
+and runs it, printing scheduler dispatch throughput for 1..N scheduler
+threads next to the mutex-protected queue it replaced.
+
+Example usage:
+    python queue_bench.py
+    python queue_bench.py --tasks 200000 --width 64 --threads 4
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+bench_dir = Path(__file__).parent
+runtime_root = bench_dir.parent.parent.parent
+aicpu_dir = runtime_root / "src" / "runtime" / "host_build_graph" / "aicpu"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Ready queue dispatch throughput")
+    parser.add_argument("--tasks", type=int, default=1000000,
+                        help="Number of tasks (default: 1000000)")
+    parser.add_argument("--width", type=int, default=256,
+                        help="Layer width (default: 256)")
+    parser.add_argument("--fanin", type=int, default=2,
+                        help="Predecessors per task (default: 2)")
+    parser.add_argument("--threads", type=int, default=4,
+                        help="Maximum scheduler threads (default: 4)")
+    args = parser.parse_args()
+
+    cxx = os.environ.get("CXX", "g++")
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = os.path.join(tmp, "ready_queue_bench")
+        cmd = [cxx, "-O2", "-std=c++17", "-pthread", f"-I{aicpu_dir}",
+               str(bench_dir / "ready_queue_bench.cpp"), "-o", binary]
+        result = subprocess.run(cmd, capture_output=True, text=True)
+        if result.returncode != 0:
+            print(f"Error: Compilation failed:\n{result.stderr}")
+            return -1
+        return subprocess.run([binary, str(args.tasks), str(args.width),
+                               str(args.fanin), str(args.threads)]).returncode
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,167 @@
+/**
+ * Ready Queue Microbenchmark
+ *
+ * Measures scheduler dispatch throughput on a synthetic layered graph with
+ * 1..N scheduler threads, using the runtime's lock-free ReadyQueue
+ * (src/runtime/host_build_graph/aicpu/ready_queue.h) and, for comparison,
+ * the mutex-protected array it replaced.
+ *
+ * Each scheduler thread repeatedly pops a ready task, "executes" it
+ * instantly, decrements the fanin of its successors and publishes the ones
+ * that became ready. With no kernel work the loop is pure queue traffic, so
+ * tasks/s reflects how the queue scales with concurrent schedulers.
+ *
+ * Usage: ready_queue_bench [tasks] [width] [fanin] [max_threads]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ready_queue.h"
+
+// Layered graph: task i in layer L depends on `fanin` tasks of layer L-1
+struct Graph {
+    int num_tasks;
+    std::vector<int> offsets;  // CSR successor lists
+    std::vector<int> edges;
+    std::vector<int> fanin;
+};
+
+static Graph make_graph(int num_tasks, int width, int fanin) {
+    Graph g;
+    g.num_tasks = num_tasks;
+    std::vector<std::vector<int>> succ(num_tasks);
+    g.fanin.assign(num_tasks, 0);
+    int stride = width / fanin > 0 ? width / fanin : 1;
+    for (int t = width; t < num_tasks; t++) {
+        int layer_start = (t / width) * width;
+        for (int k = 0; k < fanin; k++) {
+            int from = layer_start - width + (t - layer_start + k * stride) % width;
+            succ[from].push_back(t);
+            g.fanin[t]++;
+        }
+    }
+    g.offsets.resize(num_tasks + 1, 0);
+    for (int t = 0; t < num_tasks; t++) {
+        g.offsets[t + 1] = g.offsets[t] + static_cast<int>(succ[t].size());
+        g.edges.insert(g.edges.end(), succ[t].begin(), succ[t].end());
+    }
+    return g;
+}
+
+// The mutex-protected LIFO array used before the lock-free queue
+struct MutexQueue {
+    std::mutex mutex;
+    std::vector<int> tasks;
+    std::atomic<int> count{0};
+
+    void reset(int capacity) {
+        tasks.assign(capacity, 0);
+        count.store(0);
+    }
+    void push_bulk(const int* ids, int n) {
+        for (int k = 0; k < n; k++) {
+            std::lock_guard<std::mutex> lock(mutex);
+            int idx = count.load(std::memory_order_relaxed);
+            tasks[idx] = ids[k];
+            count.fetch_add(1, std::memory_order_release);
+        }
+    }
+    int pop() {
+        if (count.load(std::memory_order_acquire) == 0) {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        int n = count.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return -1;
+        }
+        count.fetch_sub(1, std::memory_order_release);
+        return tasks[n - 1];
+    }
+};
+
+struct LockFreeQueue {
+    ReadyQueue queue;
+
+    void reset(int capacity) {
+        int levels[READY_LEVELS] = {0};
+        levels[0] = capacity;
+        queue.reset(levels);
+    }
+    void push_bulk(const int* ids, int n) { queue.push_bulk(0, ids, n); }
+    int pop() { return queue.pop(); }
+};
+
+template <typename Queue>
+static double run(const Graph& g, Queue& queue, int threads) {
+    std::vector<std::atomic<int>> fanin(g.num_tasks);
+    for (int t = 0; t < g.num_tasks; t++) {
+        fanin[t].store(g.fanin[t], std::memory_order_relaxed);
+    }
+    queue.reset(g.num_tasks);
+    for (int t = 0; t < g.num_tasks; t++) {
+        if (g.fanin[t] == 0) {
+            queue.push_bulk(&t, 1);
+        }
+    }
+
+    std::atomic<int> completed{0};
+    auto worker = [&]() {
+        std::vector<int> batch;
+        while (completed.load(std::memory_order_relaxed) < g.num_tasks) {
+            int task = queue.pop();
+            if (task < 0) {
+                continue;
+            }
+            batch.clear();
+            for (int j = g.offsets[task]; j < g.offsets[task + 1]; j++) {
+                int succ = g.edges[j];
+                if (fanin[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    batch.push_back(succ);
+                }
+            }
+            if (!batch.empty()) {
+                queue.push_bulk(batch.data(), static_cast<int>(batch.size()));
+            }
+            completed.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return g.num_tasks / seconds;
+}
+
+int main(int argc, char** argv) {
+    int num_tasks = argc > 1 ? atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? atoi(argv[2]) : 256;
+    int fanin = argc > 3 ? atoi(argv[3]) : 2;
+    int max_threads = argc > 4 ? atoi(argv[4]) : 4;
+
+    Graph g = make_graph(num_tasks, width, fanin);
+    printf("Tasks: %d, width: %d, fanin: %d, edges: %zu, host CPUs: %u\n", num_tasks, width, fanin, g.edges.size(),
+        std::thread::hardware_concurrency());
+    printf("%-8s %16s %16s %8s\n", "threads", "mutex tasks/s", "lock-free tasks/s", "speedup");
+
+    MutexQueue mutex_queue;
+    LockFreeQueue lock_free_queue;
+    for (int threads = 1; threads <= max_threads; threads++) {
+        double mutex_rate = run(g, mutex_queue, threads);
+        double lock_free_rate = run(g, lock_free_queue, threads);
+        printf("%-8d %16.0f %16.0f %7.2fx\n", threads, mutex_rate, lock_free_rate, lock_free_rate / mutex_rate);
+    }
+    return 0;
+}
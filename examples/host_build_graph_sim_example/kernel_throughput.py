@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+A2A3Sim Kernel Throughput - GB/s per Kernel and ISA
+
+Compiles every kernel of this example for each simulation ISA the host can
+run (host_sim_isas(): native, avx512, avx2, sse2 or neon, scalar), loads
+its .text section into executable memory the way the sim DeviceRunner does
+and calls it directly on buffers of --elements floats. Each result is
+checked against numpy. Reports the best of --repeats calls in GB/s,
+counting every byte the kernel reads and writes.
+
+Example usage:
+    python kernel_throughput.py                          # 1M elements
+    python kernel_throughput.py --elements 16384 --isa avx2 scalar
+"""
+
+import sys
+import time
+import mmap
+import ctypes
+import argparse
+from pathlib import Path
+import numpy as np
+
+# Add parent directory to path so we can import the compiler helpers
+example_root = Path(__file__).parent
+runtime_root = Path(__file__).parent.parent.parent
+sys.path.insert(0, str(runtime_root / "python"))
+sys.path.insert(0, str(example_root))
+
+from pto_compiler import PTOCompiler, host_sim_isas
+from elf_parser import extract_text_section
+from kernels.kernel_config import KERNELS
+
+KernelFunc = ctypes.CFUNCTYPE(None, ctypes.POINTER(ctypes.c_int64))
+
+SCALAR = 1.5
+
+
+def float_bits(value):
+    """Encode a float32 scalar argument the way the orchestration does."""
+    return int(np.array([value], dtype=np.float32).view(np.uint32)[0])
+
+
+# Per kernel: argument list, expected output and bytes moved per call
+def add_case(a, b, out):
+    return [a.ctypes.data, b.ctypes.data, out.ctypes.data, a.size], a + b, 3 * a.nbytes
+
+
+def mul_case(a, b, out):
+    return [a.ctypes.data, b.ctypes.data, out.ctypes.data, a.size], a * b, 3 * a.nbytes
+
+
+def add_scalar_case(a, b, out):
+    return [a.ctypes.data, float_bits(SCALAR), out.ctypes.data, a.size], a + np.float32(SCALAR), 2 * a.nbytes
+
+
+CASES = {
+    "kernel_add": add_case,
+    "kernel_mul": mul_case,
+    "kernel_add_scalar": add_scalar_case,
+}
+
+
+class LoadedKernel:
+    """A kernel's .text section in executable memory, callable via ctypes."""
+
+    def __init__(self, text):
+        self._mem = mmap.mmap(-1, max(len(text), 1), prot=mmap.PROT_READ | mmap.PROT_WRITE | mmap.PROT_EXEC)
+        self._mem.write(text)
+        self._anchor = ctypes.c_char.from_buffer(self._mem)
+        self.func = KernelFunc(ctypes.addressof(self._anchor))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="A2A3Sim kernel throughput per ISA")
+    parser.add_argument("--elements", type=int, default=1 << 20,
+                        help="float32 elements per tensor (default: 1048576)")
+    parser.add_argument("--repeats", type=int, default=20,
+                        help="Calls per kernel and ISA, best one reported (default: 20)")
+    parser.add_argument("--isa", nargs="+", default=None,
+                        help="ISAs to measure (default: every one this host runs)")
+    args = parser.parse_args()
+
+    available = host_sim_isas()
+    isas = args.isa or available
+    for isa in isas:
+        if isa not in available:
+            print(f"Error: ISA {isa!r} is not available on this host, expected some of {available}")
+            return -1
+
+    compiler = PTOCompiler(platform="a2a3sim")
+    rng = np.random.default_rng(0)
+    a = rng.standard_normal(args.elements).astype(np.float32)
+    b = rng.standard_normal(args.elements).astype(np.float32)
+    out = np.zeros(args.elements, dtype=np.float32)
+
+    results = {}
+    for kernel in KERNELS:
+        name = Path(kernel["source"]).stem
+        case = CASES.get(name)
+        if case is None:
+            continue
+        kernel_args, expected, nbytes = case(a, b, out)
+        arg_array = (ctypes.c_int64 * len(kernel_args))(*kernel_args)
+        for isa in isas:
+            loaded = LoadedKernel(extract_text_section(compiler.compile_incore_sim(kernel["source"], isa=isa)))
+            out.fill(0)
+            loaded.func(arg_array)
+            if not np.array_equal(out, expected):
+                print(f"Error: {name} ({isa}) produced {np.sum(out != expected)} wrong elements")
+                return -1
+            best = float("inf")
+            for _ in range(args.repeats):
+                t0 = time.perf_counter()
+                loaded.func(arg_array)
+                best = min(best, time.perf_counter() - t0)
+            results[(name, isa)] = nbytes / best / 1e9
+
+    print(f"\n=== Kernel Throughput in GB/s ({args.elements} elements, best of {args.repeats}) ===")
+    print(f"{'kernel':<20}" + "".join(f"{isa:>10}" for isa in isas))
+    for name in dict.fromkeys(n for n, _ in results):
+        print(f"{name:<20}" + "".join(f"{results[(name, isa)]:>10.1f}" for isa in isas))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,12 +3,14 @@
  *
  * Implements: out[i] = src0[i] + src1[i]
  *
- * This is a simple loop-based implementation for simulation.
+ * Simulation version built on sim_tile::add.
  * The real a2a3 version uses PTO tile-based operations.
  */
 
 #include <cstdint>
 
+#include "sim_tile.h"
+
 /**
  * Element-wise addition kernel implementation
  *
@@ -22,9 +24,7 @@ extern "C" void kernel_add(int64_t* args) {
     float* src0 = reinterpret_cast<float*>(args[0]);
     float* src1 = reinterpret_cast<float*>(args[1]);
     float* out = reinterpret_cast<float*>(args[2]);
-    int size = static_cast<int>(args[3]);
+    int64_t size = args[3];
 
-    for (int i = 0; i < size; i++) {
-        out[i] = src0[i] + src1[i];
-    }
+    sim_tile::add(out, src0, src1, size);
 }
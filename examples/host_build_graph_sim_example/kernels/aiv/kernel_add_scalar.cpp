@@ -3,11 +3,13 @@
  *
  * Implements: out[i] = src[i] + scalar
  *
- * This is a simple loop-based implementation for simulation.
+ * Simulation version built on sim_tile::adds.
  */
 
 #include <cstdint>
 
+#include "sim_tile.h"
+
 /**
  * Tensor + scalar addition kernel implementation
  *
@@ -29,9 +31,7 @@ extern "C" void kernel_add_scalar(int64_t* args) {
     float scalar = conv.f32;
 
     float* out = reinterpret_cast<float*>(args[2]);
-    int size = static_cast<int>(args[3]);
+    int64_t size = args[3];
 
-    for (int i = 0; i < size; i++) {
-        out[i] = src[i] + scalar;
-    }
+    sim_tile::adds(out, src, scalar, size);
 }
@@ -8,7 +8,8 @@
  * 2. Allocates device memory via runtime->host_api
  * 3. Copies input data to device via runtime->host_api
  * 4. Records output tensor for copy-back during finalize
- * 5. Builds the task graph
+ * 5. Builds the task graph; dependencies are inferred from the tensors
+ *    each task reads and writes
  */
 
 // Include runtime.h first to get full Runtime class definition
@@ -94,13 +95,22 @@ int build_example_graph(Runtime* runtime, uint64_t* args, int arg_count) {
         uint64_t u64;
     } scalar_converter;
 
+    // Tensor regions each task reads and writes
+    TensorRegion a = {dev_a, size_a};
+    TensorRegion b = {dev_b, size_b};
+    TensorRegion c = {dev_c, BYTES};
+    TensorRegion d = {dev_d, BYTES};
+    TensorRegion e = {dev_e, BYTES};
+    TensorRegion f = {dev_f, size_f};
+
     // Task 0: c = a + b (func_id=0: kernel_add, AIV)
     uint64_t args_t0[4];
     args_t0[0] = reinterpret_cast<uint64_t>(dev_a);  // src0
     args_t0[1] = reinterpret_cast<uint64_t>(dev_b);  // src1
     args_t0[2] = reinterpret_cast<uint64_t>(dev_c);  // out
     args_t0[3] = SIZE;                                // size
-    int t0 = runtime->add_task(args_t0, 4, 0, 1);
+    TensorRegion in_t0[] = {a, b};
+    int t0 = runtime->add_task(args_t0, 4, 0, 1, in_t0, 2, &c, 1);
 
     // Task 1: d = c + 1 (func_id=1: kernel_add_scalar, AIV)
     uint64_t args_t1[4];
@@ -109,7 +119,7 @@ int build_example_graph(Runtime* runtime, uint64_t* args, int arg_count) {
     args_t1[1] = scalar_converter.u64;                // scalar=1.0
     args_t1[2] = reinterpret_cast<uint64_t>(dev_d);  // out
     args_t1[3] = SIZE;                                // size
-    int t1 = runtime->add_task(args_t1, 4, 1, 1);
+    int t1 = runtime->add_task(args_t1, 4, 1, 1, &c, 1, &d, 1);
 
     // Task 2: e = c + 2 (func_id=1: kernel_add_scalar, AIV)
     uint64_t args_t2[4];
@@ -118,7 +128,7 @@ int build_example_graph(Runtime* runtime, uint64_t* args, int arg_count) {
     args_t2[1] = scalar_converter.u64;                // scalar=2.0
     args_t2[2] = reinterpret_cast<uint64_t>(dev_e);  // out
     args_t2[3] = SIZE;                                // size
-    int t2 = runtime->add_task(args_t2, 4, 1, 1);
+    int t2 = runtime->add_task(args_t2, 4, 1, 1, &c, 1, &e, 1);
 
     // Task 3: f = d * e (func_id=2: kernel_mul, AIV)
     uint64_t args_t3[4];
@@ -126,20 +136,20 @@ int build_example_graph(Runtime* runtime, uint64_t* args, int arg_count) {
     args_t3[1] = reinterpret_cast<uint64_t>(dev_e);  // src1
     args_t3[2] = reinterpret_cast<uint64_t>(dev_f);  // out
     args_t3[3] = SIZE;                                // size
-    int t3 = runtime->add_task(args_t3, 4, 2, 1);
+    TensorRegion in_t3[] = {d, e};
+    int t3 = runtime->add_task(args_t3, 4, 2, 1, in_t3, 2, &f, 1);
 
-    // Add dependencies
-    runtime->add_successor(t0, t1);  // t0 → t1
-    runtime->add_successor(t0, t2);  // t0 → t2
-    runtime->add_successor(t1, t3);  // t1 → t3
-    runtime->add_successor(t2, t3);  // t2 → t3
+    if (t0 < 0 || t1 < 0 || t2 < 0 || t3 < 0) {
+        std::cerr << "Error: Failed to add tasks\n";
+        return -1;
+    }
 
     std::cout << "\nTasks:\n";
     std::cout << "  task" << t0 << ": c = a + b\n";
     std::cout << "  task" << t1 << ": d = c + 1\n";
     std::cout << "  task" << t2 << ": e = c + 2\n";
     std::cout << "  task" << t3 << ": f = d * e\n";
-    std::cout << "Dependencies: t0→t1, t0→t2, t1→t3, t2→t3\n";
+    std::cout << "Dependencies (inferred): t0→t1, t0→t2, t1→t3, t2→t3\n";
 
     std::cout << "Created runtime with " << runtime->get_task_count() << " tasks\n";
     runtime->print_runtime();
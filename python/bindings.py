@@ -20,8 +20,16 @@ Usage:
     launch_runtime(runtime, aicpu_thread_num=1, block_dim=1,
                  device_id=0, aicpu_binary=aicpu_bytes,
                  aicore_binary=aicore_bytes)
+    replay_runtime(runtime)  # optional: run the same graph again
 
     runtime.finalize()
+
+Several runtimes can be in flight on disjoint core partitions:
+
+    launch_runtime_async(runtime_a, partition=0, first_block=0, block_dim=4, ...)
+    launch_runtime_async(runtime_b, partition=1, first_block=4, block_dim=4, ...)
+    wait_runtime(runtime_a)
+    wait_runtime(runtime_b)
 """
 
 
@@ -29,6 +37,7 @@ from ctypes import (
     CDLL,
     POINTER,
     c_char_p,
+    c_double,
     c_int,
     c_void_p,
     c_uint8,
@@ -36,7 +45,7 @@ from ctypes import (
     c_size_t,
 )
 from pathlib import Path
-from typing import Union, List, Optional
+from typing import Dict, Tuple, Union, List, Optional
 import ctypes
 import tempfile
 
@@ -44,6 +53,33 @@ import tempfile
 # Module-level library reference
 _lib = None
 
+# launch_runtime() sched_policy names -> RUNTIME_SCHED_* in runtime.h
+SCHED_POLICIES = {
+    "graph": -1,
+    "fifo": 0,
+    "lifo": 1,
+    "critical_path": 2,
+    "shortest_job": 3,
+    "locality": 4,
+}
+
+# Core partitions per device (RUNTIME_MAX_PARTITIONS in runtime.h)
+MAX_PARTITIONS = 8
+
+# set_idle_wait() mode names -> RUNTIME_WAIT_* in runtime.h
+IDLE_WAIT_MODES = {
+    "spin": 0,
+    "yield": 1,
+    "block": 2,
+}
+
+# set_core_backend() backend names -> SIM_CORE_* in a2a3sim's device_runner.h
+CORE_BACKENDS = {
+    "threads": 0,
+    "fibers": 1,
+    "direct": 2,
+}
+
 
 # ============================================================================
 # Runtime Library Loader
@@ -102,9 +138,37 @@ class RuntimeLibraryLoader:
             c_size_t,           # aicpu_size
             POINTER(c_uint8),   # aicore_binary
             c_size_t,           # aicore_size
+            c_int,              # mailbox_depth
+            c_int,              # resolve_on_aicore
+            c_int,              # chain_successors
+            c_int,              # sched_policy
+            c_int,              # rebalance_cores
+            c_int,              # sched_group_size
         ]
         self.lib.launch_runtime.restype = c_int
 
+        # launch_runtime_async - start a runtime on a core partition
+        self.lib.launch_runtime_async.argtypes = [
+            c_void_p,           # runtime
+            c_int,              # partition
+            c_int,              # first_block
+        ] + self.lib.launch_runtime.argtypes[1:]
+        self.lib.launch_runtime_async.restype = c_int
+
+        # replay_runtime_async / wait_runtime - start a replay, wait for a launch
+        self.lib.replay_runtime_async.argtypes = [c_void_p]
+        self.lib.replay_runtime_async.restype = c_int
+        self.lib.wait_runtime.argtypes = [c_void_p]
+        self.lib.wait_runtime.restype = c_int
+
+        # replay_runtime - relaunch an already launched runtime
+        self.lib.replay_runtime.argtypes = [c_void_p]
+        self.lib.replay_runtime.restype = c_int
+
+        # set_runtime_param - rebind a named graph parameter
+        self.lib.set_runtime_param.argtypes = [c_void_p, c_char_p, c_uint64]
+        self.lib.set_runtime_param.restype = c_int
+
         # finalize_runtime - validate + cleanup
         self.lib.finalize_runtime.argtypes = [c_void_p]
         self.lib.finalize_runtime.restype = c_int
@@ -117,6 +181,20 @@ class RuntimeLibraryLoader:
         self.lib.set_device.argtypes = [c_int]
         self.lib.set_device.restype = c_int
 
+        # get_cost_model / set_cost_model - export and pre-seed the cost model
+        self.lib.get_cost_model.argtypes = [POINTER(c_uint64), POINTER(c_double), POINTER(c_double), c_int]
+        self.lib.get_cost_model.restype = c_int
+        self.lib.set_cost_model.argtypes = [POINTER(c_uint64), POINTER(c_double), POINTER(c_double), c_int]
+        self.lib.set_cost_model.restype = c_int
+
+        # set_idle_wait - how idle cores and AICPU threads wait
+        self.lib.set_idle_wait.argtypes = [c_int, c_int, c_int]
+        self.lib.set_idle_wait.restype = c_int
+
+        # set_core_backend - threads or fibers for simulated AICores
+        self.lib.set_core_backend.argtypes = [c_int, c_int]
+        self.lib.set_core_backend.restype = c_int
+
 
 # ============================================================================
 # Python Wrapper Classes
@@ -291,6 +369,12 @@ def launch_runtime(
     device_id: int,
     aicpu_binary: bytes,
     aicore_binary: bytes,
+    mailbox_depth: int = 1,
+    resolve_on_aicore: bool = False,
+    chain_successors: bool = False,
+    sched_policy: str = "graph",
+    rebalance_cores: bool = False,
+    sched_group_size: int = 0,
 ) -> None:
     """
 
@@ -306,6 +390,26 @@ def launch_runtime(
         device_id: Device ID (0-15)
         aicpu_binary: Binary data of AICPU shared object
         aicore_binary: Binary data of AICore kernel
+        mailbox_depth: Tasks in flight per core (1-4). Above 1 the AICPU
+            stages the next task while the current one runs, so the core
+            does not wait for the dispatch round trip between tasks.
+        resolve_on_aicore: Let each AICore resolve its finished task's
+            successors and publish the ready ones to a shared queue in GM;
+            the AICPU then only places and dispatches tasks
+        chain_successors: Let a core that finishes a task run its chain
+            successor (same core type, no other predecessor) immediately,
+            without an AICPU round trip
+        sched_policy: AICPU scheduling policy, one of SCHED_POLICIES:
+            "graph" keeps the order and placement chosen by the
+            orchestration; "fifo", "lifo", "critical_path",
+            "shortest_job" and "locality" replace them
+        rebalance_cores: Let an AICPU scheduler thread whose cores complete
+            tasks slowest per block hand idle blocks to the fastest one.
+            block_dim need not be a multiple of aicpu_thread_num either way.
+        sched_group_size: Group the AICPU scheduler threads under
+            coordinators, this many threads per group (0 or 1: one flat
+            group). Threads then steal and rebalance within their group and
+            coordinators balance work between groups.
 
     Raises:
         RuntimeError: If not initialized or execution fails
@@ -315,12 +419,79 @@ def launch_runtime(
     if _lib is None:
         raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
 
+    rc = _lib.launch_runtime(
+        runtime._handle,
+        *_launch_args(aicpu_thread_num, block_dim, device_id, aicpu_binary, aicore_binary, mailbox_depth,
+                      resolve_on_aicore, chain_successors, sched_policy, rebalance_cores, sched_group_size),
+    )
+    if rc != 0:
+        raise RuntimeError(f"launch_runtime failed: {rc}")
+
+
+def launch_runtime_async(
+    runtime: "Runtime",
+    partition: int,
+    first_block: int,
+    aicpu_thread_num: int,
+    block_dim: int,
+    device_id: int,
+    aicpu_binary: bytes,
+    aicore_binary: bytes,
+    mailbox_depth: int = 1,
+    resolve_on_aicore: bool = False,
+    chain_successors: bool = False,
+    sched_policy: str = "graph",
+    rebalance_cores: bool = False,
+    sched_group_size: int = 0,
+) -> None:
+    """
+
+    Start a runtime on a core partition of the device without waiting.
+
+    The runtime occupies blocks [first_block, first_block + block_dim) and
+    is scheduled by its partition's own AICPU executor, so runtimes on
+    other partitions with disjoint blocks run at the same time. Call
+    wait_runtime() before launching on the partition or its blocks again.
+    On a2a3 the launch completes before this returns.
+
+    Args:
+        runtime: Initialized Runtime, not in flight
+        partition: Partition index, 0 to MAX_PARTITIONS - 1, not in flight
+        first_block: First block of the partition
+        Remaining arguments: as for launch_runtime()
+
+    Raises:
+        RuntimeError: If not loaded, the partition or its blocks are in
+            use, or the launch fails to start
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    rc = _lib.launch_runtime_async(
+        runtime._handle,
+        partition,
+        first_block,
+        *_launch_args(aicpu_thread_num, block_dim, device_id, aicpu_binary, aicore_binary, mailbox_depth,
+                      resolve_on_aicore, chain_successors, sched_policy, rebalance_cores, sched_group_size),
+    )
+    if rc != 0:
+        raise RuntimeError(f"launch_runtime_async failed: {rc}")
+
+
+def _launch_args(aicpu_thread_num, block_dim, device_id, aicpu_binary, aicore_binary, mailbox_depth,
+                 resolve_on_aicore, chain_successors, sched_policy, rebalance_cores, sched_group_size):
+    """C arguments of launch_runtime() after the runtime handle."""
+
+    if sched_policy not in SCHED_POLICIES:
+        raise ValueError(f"Unknown sched_policy {sched_policy!r}, expected one of {list(SCHED_POLICIES)}")
+
     # Convert bytes to ctypes arrays
     aicpu_array = (c_uint8 * len(aicpu_binary)).from_buffer_copy(aicpu_binary)
     aicore_array = (c_uint8 * len(aicore_binary)).from_buffer_copy(aicore_binary)
 
-    rc = _lib.launch_runtime(
-        runtime._handle,
+    return (
         aicpu_thread_num,
         block_dim,
         device_id,
@@ -328,15 +499,247 @@ def launch_runtime(
         len(aicpu_binary),
         aicore_array,
         len(aicore_binary),
+        mailbox_depth,
+        1 if resolve_on_aicore else 0,
+        1 if chain_successors else 0,
+        SCHED_POLICIES[sched_policy],
+        1 if rebalance_cores else 0,
+        sched_group_size,
     )
+
+
+def replay_runtime(runtime: "Runtime") -> None:
+    """
+
+    Execute a previously launched runtime again.
+
+    Reuses the task graph built by runtime.initialize() and the launch
+    parameters of the last launch_runtime() call; orchestration is not
+    re-run. Fanin counts are restored from the snapshot captured at graph
+    build time. On a2a3 the device copy of the graph stays resident.
+
+    Args:
+        runtime: Runtime that has already been executed with launch_runtime()
+
+    Raises:
+        RuntimeError: If not loaded, the runtime was never launched, or
+            execution fails
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    rc = _lib.replay_runtime(runtime._handle)
     if rc != 0:
-        raise RuntimeError(f"launch_runtime failed: {rc}")
+        raise RuntimeError(f"replay_runtime failed: {rc}")
+
+
+def replay_runtime_async(runtime: "Runtime") -> None:
+    """
+
+    Start replay_runtime() on the runtime's partition without waiting.
+
+    Args:
+        runtime: Runtime already launched, not in flight
+
+    Raises:
+        RuntimeError: If not loaded, the runtime was never launched, or its
+            partition or blocks are in use
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    rc = _lib.replay_runtime_async(runtime._handle)
+    if rc != 0:
+        raise RuntimeError(f"replay_runtime_async failed: {rc}")
+
+
+def wait_runtime(runtime: "Runtime") -> None:
+    """
+
+    Wait for launch_runtime_async() or replay_runtime_async() to finish.
+
+    Args:
+        runtime: Runtime in flight
+
+    Raises:
+        RuntimeError: If not loaded, the runtime is not in flight, or
+            execution failed
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    rc = _lib.wait_runtime(runtime._handle)
+    if rc != 0:
+        raise RuntimeError(f"wait_runtime failed: {rc}")
 
 
 # ============================================================================
 # Public API
 # ============================================================================
 
+def set_runtime_param(runtime: "Runtime", name: str, value: int) -> None:
+    """
+    Rebind a named graph parameter before replay_runtime().
+
+    Writes value (typically a device pointer) into every task argument the
+    orchestration bound to name. Only those argument words are uploaded at
+    the next replay. Buffers bound this way are owned by the caller and are
+    not copied back by runtime.finalize().
+
+    Args:
+        runtime: Initialized Runtime
+        name: Parameter name used by the orchestration, e.g. "input_a"
+        value: New argument value
+
+    Raises:
+        RuntimeError: If not loaded, the runtime is in flight (wait_runtime()
+            first) or the parameter name is unknown
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    rc = _lib.set_runtime_param(runtime._handle, name.encode('utf-8'), value)
+    if rc != 0:
+        raise RuntimeError(f"set_runtime_param failed for '{name}': {rc}")
+
+
+def get_cost_model() -> Dict[int, Tuple[int, float, float]]:
+    """
+    Export the online cost model.
+
+    Every launch and replay measures each task's execution time and folds
+    it, per func_id, into a moving average and variance kept across
+    launches and runtimes. Ranks (critical-path and shortest-job
+    priorities) use these estimates for kernels without an explicit cost.
+
+    Returns:
+        {func_id: (samples, mean, variance)} for every measured func_id,
+        times in device timer ticks (nanoseconds on a2a3sim)
+
+    Raises:
+        RuntimeError: If not loaded or the export fails
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    count = _lib.get_cost_model(None, None, None, 0)
+    if count < 0:
+        raise RuntimeError(f"get_cost_model failed: {count}")
+    samples = (c_uint64 * count)()
+    mean = (c_double * count)()
+    var = (c_double * count)()
+    rc = _lib.get_cost_model(samples, mean, var, count)
+    if rc < 0:
+        raise RuntimeError(f"get_cost_model failed: {rc}")
+    return {f: (samples[f], mean[f], var[f]) for f in range(count) if samples[f] > 0}
+
+
+def set_cost_model(model: Dict[int, Tuple[int, float, float]]) -> None:
+    """
+    Pre-seed the online cost model, e.g. with get_cost_model() output
+    saved by a previous run. Replaces the whole table; func_ids missing from
+    model have no estimate. Applies to runtimes initialized afterwards.
+
+    Args:
+        model: {func_id: (samples, mean, variance)}
+
+    Raises:
+        RuntimeError: If not loaded or an entry is invalid
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+
+    count = max(model, default=-1) + 1
+    samples = (c_uint64 * max(count, 1))()
+    mean = (c_double * max(count, 1))()
+    var = (c_double * max(count, 1))()
+    for f, (n, m, v) in model.items():
+        samples[f], mean[f], var[f] = n, m, v
+    rc = _lib.set_cost_model(samples, mean, var, count)
+    if rc != 0:
+        raise RuntimeError(f"set_cost_model failed: {rc}")
+
+
+def set_idle_wait(mode: str = "block", spin_polls: int = 64, yield_polls: int = 64) -> None:
+    """
+    Choose how idle AICores and AICPU threads wait for each other.
+
+    Every mode first polls spin_polls times; "yield" then yields the host
+    CPU between polls, "block" yields for yield_polls more polls and then
+    sleeps until the other side writes the handshake, "spin" keeps polling.
+    Only a2a3sim distinguishes the modes (default "block"): simulated cores
+    usually outnumber host CPUs and polling ones starve those running
+    kernels. Applies to launches and replays started afterwards.
+
+    Args:
+        mode: Idle wait mode name (see IDLE_WAIT_MODES)
+        spin_polls: Idle polls that only spin
+        yield_polls: Yielding polls before sleeping (block mode)
+
+    Raises:
+        ValueError: If mode is unknown
+        RuntimeError: If not loaded or the poll counts are invalid
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+    if mode not in IDLE_WAIT_MODES:
+        raise ValueError(f"Unknown idle wait mode {mode!r}, expected one of {list(IDLE_WAIT_MODES)}")
+
+    rc = _lib.set_idle_wait(IDLE_WAIT_MODES[mode], spin_polls, yield_polls)
+    if rc != 0:
+        raise RuntimeError(f"set_idle_wait failed: {rc}")
+
+
+def set_core_backend(backend: str = "threads", host_threads: int = 0) -> None:
+    """
+    Choose how simulated AICores execute.
+
+    "threads" runs every AICore on its own host thread. "fibers" runs them
+    as user-space fibers on host_threads host threads (0 = one per host
+    CPU, at least 3), switching at handshake polls, so topologies much
+    larger than the host run without oversubscribing it. "direct" emulates
+    no AICPU/AICore handshakes at all: host_threads work-stealing workers
+    (0 = one per host CPU) run the graph straight from its dependency
+    counts, calling the same kernels, and one worker runs the tasks in a
+    fixed order. Scheduling policies, mailboxes and chaining do not apply
+    to "direct". Results are the same on every backend. Only a2a3sim has
+    "fibers" and "direct". Applies to launches and replays started
+    afterwards.
+
+    Args:
+        backend: Backend name (see CORE_BACKENDS)
+        host_threads: Fiber host threads or direct workers, 0 = automatic
+
+    Raises:
+        ValueError: If backend is unknown
+        RuntimeError: If not loaded or the platform rejects the backend
+    """
+
+    global _lib
+    if _lib is None:
+        raise RuntimeError("Runtime not loaded. Call bind_host_binary() first.")
+    if backend not in CORE_BACKENDS:
+        raise ValueError(f"Unknown core backend {backend!r}, expected one of {list(CORE_BACKENDS)}")
+
+    rc = _lib.set_core_backend(CORE_BACKENDS[backend], host_threads)
+    if rc != 0:
+        raise RuntimeError(f"set_core_backend failed: {rc}")
+
+
 def bind_host_binary(lib_path: Union[str, Path, bytes]) -> type:
     """
 
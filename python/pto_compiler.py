@@ -1,4 +1,5 @@
 import os
+import platform as host_platform
 import subprocess
 import sys
 import time
@@ -6,6 +7,61 @@ from pathlib import Path
 from typing import List, Optional
 
 
+# Target flags of each simulation kernel ISA by host architecture
+# (compile_incore_sim()); sim_tile.h picks its SIMD path from the target
+# macros they define. "scalar" forces its scalar path.
+SIM_ISA_FLAGS = {
+    "x86_64": {
+        "native": ["-march=native"],
+        "avx512": ["-march=x86-64-v4"],
+        "avx2": ["-march=x86-64-v3"],
+        "sse2": ["-march=x86-64"],
+        "scalar": ["-march=x86-64", "-DSIM_TILE_SCALAR", "-fno-tree-vectorize"],
+    },
+    "aarch64": {
+        "native": ["-mcpu=native"],
+        "neon": ["-march=armv8-a"],
+        "scalar": ["-march=armv8-a", "-DSIM_TILE_SCALAR", "-fno-tree-vectorize"],
+    },
+}
+
+# CPU flags (/proc/cpuinfo) an x86-64 host needs to run each ISA
+_X86_ISA_CPU_FLAGS = {
+    "avx512": {"avx512f", "avx512bw", "avx512cd", "avx512dq", "avx512vl"},
+    "avx2": {"avx", "avx2", "fma", "bmi1", "bmi2", "f16c", "movbe"},
+}
+
+
+def _host_arch() -> str:
+    machine = host_platform.machine().lower()
+    return "aarch64" if machine in ("arm64", "aarch64") else machine
+
+
+def host_sim_isas() -> List[str]:
+    """
+    List the simulation kernel ISAs this host can compile and run.
+
+    Returns:
+        ISA names accepted by compile_incore_sim(), "native" first
+    """
+    isas = SIM_ISA_FLAGS.get(_host_arch())
+    if isas is None:
+        return ["native"]
+    if _host_arch() != "x86_64":
+        return list(isas)
+
+    cpu_flags = set()
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("flags"):
+                    cpu_flags = set(line.split(":", 1)[1].split())
+                    break
+    except OSError:
+        pass
+    return [isa for isa in isas if _X86_ISA_CPU_FLAGS.get(isa, set()) <= cpu_flags]
+
+
 class PTOCompiler:
     """
     Compiler for PTO kernels and orchestration functions.
@@ -72,7 +128,8 @@ class PTOCompiler:
         source_path: str,
         core_type: str = "aiv",
         pto_isa_root: Optional[str] = None,
-        extra_include_dirs: Optional[List[str]] = None
+        extra_include_dirs: Optional[List[str]] = None,
+        sim_isa: Optional[str] = None
     ) -> bytes:
         """
         Compile a kernel source file. Dispatches based on platform:
@@ -84,6 +141,7 @@ class PTOCompiler:
             core_type: Core type: "aic" (cube) or "aiv" (vector). Default: "aiv"
             pto_isa_root: Path to PTO-ISA root directory. Required for a2a3.
             extra_include_dirs: Additional include directories
+            sim_isa: Simulation kernel ISA (see compile_incore_sim()), a2a3sim only
 
         Returns:
             Binary contents of the compiled .o file
@@ -95,7 +153,7 @@ class PTOCompiler:
         """
         # For simulation platform, dispatch to compile_incore_sim
         if self.platform == "a2a3sim":
-            return self.compile_incore_sim(source_path)
+            return self.compile_incore_sim(source_path, isa=sim_isa, extra_include_dirs=extra_include_dirs)
 
         # For real hardware (a2a3), continue with ccec compilation
         # Validate source file exists
@@ -322,27 +380,44 @@ class PTOCompiler:
         print(f"[Orchestration] Compilation successful: {len(binary_data)} bytes")
         return binary_data
 
-    def compile_incore_sim(self, source_path: str) -> bytes:
+    def compile_incore_sim(
+        self,
+        source_path: str,
+        isa: Optional[str] = None,
+        extra_include_dirs: Optional[List[str]] = None
+    ) -> bytes:
         """
         Compile a simulation kernel to .o using g++.
 
         This compiles a simulation kernel (plain C++ code) to an object file,
         which can then have its .text section extracted for execution on host.
+        The kernel can include sim_tile.h (src/platform/a2a3sim/aicore) for
+        SIMD tile operations; isa chooses the target flags and with them its
+        vector path (see SIM_ISA_FLAGS and host_sim_isas()).
 
         Args:
             source_path: Path to kernel source file (.cpp)
+            isa: Target ISA of this host architecture, e.g. "avx2" or
+                 "scalar" (default: "native", the host CPU's)
+            extra_include_dirs: Additional include directories
 
         Returns:
             Binary contents of the compiled .o file
 
         Raises:
             FileNotFoundError: If source file not found
+            ValueError: If isa is unknown for this host architecture
             RuntimeError: If compilation fails
         """
         source_path = os.path.abspath(source_path)
         if not os.path.isfile(source_path):
             raise FileNotFoundError(f"Source file not found: {source_path}")
 
+        isa = isa or "native"
+        arch_isas = SIM_ISA_FLAGS.get(_host_arch(), {"native": []})
+        if isa not in arch_isas:
+            raise ValueError(f"Unknown sim ISA {isa!r} for {_host_arch()}, expected one of {list(arch_isas)}")
+
         # Generate output path
         timestamp = int(time.time() * 1000)
         output_path = f"/tmp/sim_kernel_{timestamp}_{os.getpid()}.o"
@@ -352,6 +427,13 @@ class PTOCompiler:
             "g++", "-c",
             "-O2", "-fPIC", "-fno-plt",
             "-std=c++17",
+        ] + arch_isas[isa] + [
+            f"-I{self.project_root / 'src' / 'platform' / 'a2a3sim' / 'aicore'}",
+        ]
+        if extra_include_dirs:
+            for inc_dir in extra_include_dirs:
+                cmd.append(f"-I{os.path.abspath(inc_dir)}")
+        cmd += [
             "-o", output_path,
             source_path
         ]
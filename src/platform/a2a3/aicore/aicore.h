@@ -21,4 +21,22 @@
 #define __out__
 #endif
 
+// Wait hint while spinning on another AICore (each AICore is a physical core)
+#define aicore_spin_pause() ((void)0)
+
+// Fiber backend hooks of the simulator: every AICore is a physical core, so
+// polls never switch and MIX gangs need no lock
+#define aicore_fiber_poll(idle) ((void)(idle))
+#define aicore_gang_begin(task_id) ((void)0)
+#define aicore_gang_end(members) ((void)0)
+
+// Blocking idle waits: AICores only poll, so arming yields no token and
+// nothing ever blocks or needs a wake
+#define aicore_wait_arm(word) 0u
+#define aicore_wait_block(word, armed) ((void)(armed))
+#define aicore_wake(word) ((void)0)
+
+// Device timer for task start/end stamps: the system counter
+#define aicore_clock() static_cast<uint64_t>(get_sys_cnt())
+
 #endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+/**
+ * AICPU Platform Hooks
+ *
+ * Each scheduler thread owns an AICPU core, so waiting needs no hint.
+ */
+
+#pragma once
+
+// Wait hint for an idle scheduler thread past its spin budget
+#define aicpu_spin_pause() ((void)0)
+
+// Blocking idle waits: scheduler threads only poll on hardware, so arming
+// yields no token and nothing ever blocks or needs a wake
+#define aicpu_wait_arm(word) 0u
+#define aicpu_wait_block(word, armed) ((void)(armed), false)
+#define aicpu_wake(word) ((void)0)
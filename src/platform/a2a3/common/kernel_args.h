@@ -42,7 +42,7 @@ extern "C" {
  *
  * Note: AICore kernels receive Runtime* directly, not KernelArgs
  *       - AICPU: accesses runtime_args->workers directly
- *       - AICore: receives Runtime* pointer with workers at offset 0
+ *       - AICore: receives Runtime* pointer and follows runtime->workers
  */
 struct KernelArgs {
     uint64_t unused[5] = {0};          // Alignment padding (required by CANN runtime offset)
@@ -51,6 +51,34 @@ int KernelArgsHelper::finalize_device_args() {
     return 0;
 }
 
+int KernelArgsHelper::upload_int_array(void** dev_buf, const int* host_data, size_t size, int** dev_field,
+    const char* name) {
+    if (*dev_buf != nullptr) {
+        allocator_->free(*dev_buf);
+        *dev_buf = nullptr;
+    }
+    // Always allocate so the device pointer is valid even for empty arrays
+    *dev_buf = allocator_->alloc(size > 0 ? size : sizeof(int));
+    if (*dev_buf == nullptr) {
+        std::cerr << "Error: Alloc for " << name << " failed\n";
+        return -1;
+    }
+    if (size > 0) {
+        int rc = rtMemcpy(*dev_buf, size, host_data, size, RT_MEMCPY_HOST_TO_DEVICE);
+        if (rc != 0) {
+            std::cerr << "Error: rtMemcpy for " << name << " failed: " << rc << '\n';
+            return rc;
+        }
+    }
+    int* dev_ptr = reinterpret_cast<int*>(*dev_buf);
+    int rc = rtMemcpy(dev_field, sizeof(int*), &dev_ptr, sizeof(int*), RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for " << name << " pointer failed: " << rc << '\n';
+        return rc;
+    }
+    return 0;
+}
+
 int KernelArgsHelper::init_runtime_args(const Runtime& host_runtime, MemoryAllocator& allocator) {
     allocator_ = &allocator;
 
@@ -70,10 +98,248 @@ int KernelArgsHelper::init_runtime_args(const Runtime& host_runtime, MemoryAlloc
         args.runtime_args = nullptr;
         return rc;
     }
+
+    // Upload the handshake buffers, sized for this launch's cores. The
+    // doorbell words are cleared by the AICPU at every launch, so they are
+    // allocated but not uploaded.
+    if (workers_dev_ != nullptr) {
+        allocator_->free(workers_dev_);
+    }
+    size_t workers_size = host_runtime.worker_count * sizeof(Handshake);
+    workers_dev_ = allocator_->alloc(workers_size);
+    if (workers_dev_ == nullptr) {
+        std::cerr << "Error: Alloc for handshake buffers failed\n";
+        return -1;
+    }
+    rc = rtMemcpy(workers_dev_, workers_size, host_runtime.workers, workers_size, RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc == 0) {
+        rc = rtMemcpy(&args.runtime_args->workers, sizeof(void*), &workers_dev_, sizeof(void*),
+            RT_MEMCPY_HOST_TO_DEVICE);
+    }
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for handshake buffers failed: " << rc << '\n';
+        return rc;
+    }
+    if (doorbells_dev_ != nullptr) {
+        allocator_->free(doorbells_dev_);
+    }
+    doorbells_dev_ = allocator_->alloc(host_runtime.doorbell_count * sizeof(Doorbell));
+    if (doorbells_dev_ == nullptr) {
+        std::cerr << "Error: Alloc for doorbells failed\n";
+        return -1;
+    }
+    rc = rtMemcpy(&args.runtime_args->doorbells, sizeof(void*), &doorbells_dev_, sizeof(void*),
+        RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for doorbell pointer failed: " << rc << '\n';
+        return rc;
+    }
+
+    // Upload the packed successor edges (sized by the real edge count), the
+    // fanin snapshot and the task ranks, and point the device Runtime at them
+    size_t edges_size = host_runtime.fanout_edge_count * sizeof(int);
+    rc = upload_int_array(&fanout_edges_dev_, host_runtime.fanout_edges, edges_size,
+        &args.runtime_args->fanout_edges, "fanout edges");
+    if (rc != 0) {
+        return rc;
+    }
+    size_t snapshot_size = host_runtime.get_task_count() * sizeof(int);
+    rc = upload_int_array(&fanin_snapshot_dev_, host_runtime.fanin_snapshot, snapshot_size,
+        &args.runtime_args->fanin_snapshot, "fanin snapshot");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = upload_int_array(&task_ranks_dev_, host_runtime.task_ranks, snapshot_size,
+        &args.runtime_args->task_ranks, "task ranks");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = upload_int_array(&chain_next_dev_, host_runtime.chain_next, snapshot_size,
+        &args.runtime_args->chain_next, "chain successors");
+    if (rc != 0) {
+        return rc;
+    }
+
+    // The resolved queue's slots are scratch cleared by the AICPU at every
+    // launch, so they are allocated but not uploaded
+    if (resolved_ids_dev_ != nullptr) {
+        allocator_->free(resolved_ids_dev_);
+    }
+    resolved_ids_dev_ = allocator_->alloc(snapshot_size > 0 ? snapshot_size : sizeof(int));
+    if (resolved_ids_dev_ == nullptr) {
+        std::cerr << "Error: Alloc for resolved queue failed\n";
+        return -1;
+    }
+    rc = rtMemcpy(&args.runtime_args->resolved_ids, sizeof(void*), &resolved_ids_dev_, sizeof(void*),
+        RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for resolved queue pointer failed: " << rc << '\n';
+        return rc;
+    }
+
+    // Upload the task chunks back to back into one block and point the
+    // device chunk table into it, so device task addresses follow the same
+    // chunk indexing. Only the used part of each hot and cold array is copied.
+    if (task_block_dev_ != nullptr) {
+        allocator_->free(task_block_dev_);
+        task_block_dev_ = nullptr;
+    }
+    int task_count = host_runtime.get_task_count();
+    int chunk_count = host_runtime.task_chunk_count;
+    size_t task_block_size = (chunk_count > 0 ? chunk_count : 1) * sizeof(TaskChunk);
+    task_block_dev_ = allocator_->alloc(task_block_size);
+    if (task_block_dev_ == nullptr) {
+        std::cerr << "Error: Alloc for task block failed\n";
+        return -1;
+    }
+    std::vector<TaskChunk*> chunk_table(chunk_count);
+    for (int c = 0; c < chunk_count; c++) {
+        int chunk_tasks = task_count - c * RUNTIME_TASK_CHUNK_SIZE;
+        if (chunk_tasks > RUNTIME_TASK_CHUNK_SIZE) {
+            chunk_tasks = RUNTIME_TASK_CHUNK_SIZE;
+        }
+        chunk_table[c] = reinterpret_cast<TaskChunk*>(task_block_dev_) + c;
+        if (chunk_tasks <= 0) {
+            continue;
+        }
+        const TaskChunk* host_chunk = host_runtime.task_chunks[c];
+        size_t sched_size = chunk_tasks * sizeof(TaskSched);
+        rc = rtMemcpy(chunk_table[c]->sched, sched_size, host_chunk->sched, sched_size, RT_MEMCPY_HOST_TO_DEVICE);
+        if (rc == 0) {
+            size_t tasks_size = chunk_tasks * sizeof(Task);
+            rc = rtMemcpy(chunk_table[c]->tasks, tasks_size, host_chunk->tasks, tasks_size, RT_MEMCPY_HOST_TO_DEVICE);
+        }
+        if (rc != 0) {
+            std::cerr << "Error: rtMemcpy for task chunk " << c << " failed: " << rc << '\n';
+            return rc;
+        }
+    }
+    if (chunk_count > 0) {
+        size_t table_size = chunk_count * sizeof(TaskChunk*);
+        rc = rtMemcpy(args.runtime_args->task_chunks, table_size, chunk_table.data(), table_size,
+            RT_MEMCPY_HOST_TO_DEVICE);
+        if (rc != 0) {
+            std::cerr << "Error: rtMemcpy for task chunk table failed: " << rc << '\n';
+            return rc;
+        }
+    }
     return 0;
 }
 
+// Copy one coalesced range of patched argument words to the device
+static int copy_param_range(uint8_t* dev_start, const uint8_t* host_start, size_t size) {
+    int rc = rtMemcpy(dev_start, size, host_start, size, RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for parameter patch failed: " << rc << '\n';
+    }
+    return rc;
+}
+
+int KernelArgsHelper::upload_dirty_params(const Runtime& host_runtime) {
+    if (task_block_dev_ == nullptr) {
+        std::cerr << "Error: Task block is not resident on device\n";
+        return -1;
+    }
+    TaskChunk* dev_chunks = reinterpret_cast<TaskChunk*>(task_block_dev_);
+    const RuntimeParam* params = host_runtime.get_params();
+    const RuntimeParamSlot* slots = host_runtime.get_param_slots();
+
+    // Pending range of adjacent words: [dev_start, dev_start + size)
+    uint8_t* dev_start = nullptr;
+    const uint8_t* host_start = nullptr;
+    size_t size = 0;
+
+    for (int p = 0; p < host_runtime.get_param_count(); p++) {
+        if (!params[p].dirty) {
+            continue;
+        }
+        for (int s = params[p].first_slot; s >= 0; s = slots[s].next) {
+            int task_id = slots[s].task_id;
+            int chunk = task_id >> RUNTIME_TASK_CHUNK_SHIFT;
+            int index = task_id & (RUNTIME_TASK_CHUNK_SIZE - 1);
+            uint8_t* dev_word = reinterpret_cast<uint8_t*>(&dev_chunks[chunk].tasks[index].args[slots[s].arg_index]);
+            const uint8_t* host_word =
+                reinterpret_cast<const uint8_t*>(&host_runtime.task_at(task_id)->args[slots[s].arg_index]);
+            if (size > 0 && dev_word == dev_start + size && host_word == host_start + size) {
+                size += sizeof(uint64_t);
+                continue;
+            }
+            if (size > 0) {
+                int rc = copy_param_range(dev_start, host_start, size);
+                if (rc != 0) {
+                    return rc;
+                }
+            }
+            dev_start = dev_word;
+            host_start = host_word;
+            size = sizeof(uint64_t);
+        }
+    }
+    return size > 0 ? copy_param_range(dev_start, host_start, size) : 0;
+}
+
+int KernelArgsHelper::upload_cost_model(const Runtime& host_runtime, bool ranks_changed) {
+    int rc = rtMemcpy(args.runtime_args->cost_model, sizeof(host_runtime.cost_model), host_runtime.cost_model,
+        sizeof(host_runtime.cost_model), RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for cost model failed: " << rc << '\n';
+        return rc;
+    }
+    if (!ranks_changed || task_ranks_dev_ == nullptr) {
+        return 0;
+    }
+    size_t ranks_size = host_runtime.get_task_count() * sizeof(int);
+    if (ranks_size > 0) {
+        rc = rtMemcpy(task_ranks_dev_, ranks_size, host_runtime.task_ranks, ranks_size, RT_MEMCPY_HOST_TO_DEVICE);
+        if (rc != 0) {
+            std::cerr << "Error: rtMemcpy for task ranks failed: " << rc << '\n';
+        }
+    }
+    return rc;
+}
+
+int KernelArgsHelper::download_func_samples(Runtime& host_runtime) {
+    int rc = rtMemcpy(host_runtime.func_samples, sizeof(host_runtime.func_samples), args.runtime_args->func_samples,
+        sizeof(host_runtime.func_samples), RT_MEMCPY_DEVICE_TO_HOST);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for measured task durations failed: " << rc << '\n';
+    }
+    return rc;
+}
+
 int KernelArgsHelper::finalize_runtime_args() {
+    if (fanout_edges_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(fanout_edges_dev_);
+        fanout_edges_dev_ = nullptr;
+    }
+    if (fanin_snapshot_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(fanin_snapshot_dev_);
+        fanin_snapshot_dev_ = nullptr;
+    }
+    if (task_ranks_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(task_ranks_dev_);
+        task_ranks_dev_ = nullptr;
+    }
+    if (chain_next_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(chain_next_dev_);
+        chain_next_dev_ = nullptr;
+    }
+    if (resolved_ids_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(resolved_ids_dev_);
+        resolved_ids_dev_ = nullptr;
+    }
+    if (task_block_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(task_block_dev_);
+        task_block_dev_ = nullptr;
+    }
+    if (workers_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(workers_dev_);
+        workers_dev_ = nullptr;
+    }
+    if (doorbells_dev_ != nullptr && allocator_ != nullptr) {
+        allocator_->free(doorbells_dev_);
+        doorbells_dev_ = nullptr;
+    }
     if (args.runtime_args != nullptr && allocator_ != nullptr) {
         int rc = allocator_->free(args.runtime_args);
         args.runtime_args = nullptr;
@@ -242,7 +508,33 @@ int DeviceRunner::run(Runtime& runtime,
     int device_id,
     const std::vector<uint8_t>& aicpu_so_binary,
     const std::vector<uint8_t>& aicore_kernel_binary,
-    int launch_aicpu_num) {
+    int launch_aicpu_num,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size,
+    int partition) {
+    if (partition < 0 || partition >= RUNTIME_MAX_PARTITIONS) {
+        std::cerr << "Error: partition (" << partition << ") must be between 0 and " << RUNTIME_MAX_PARTITIONS - 1
+                  << '\n';
+        return -1;
+    }
+    if (mailbox_depth < 1 || mailbox_depth > RUNTIME_MAX_MAILBOX_DEPTH) {
+        std::cerr << "Error: mailbox_depth (" << mailbox_depth << ") must be between 1 and "
+                  << RUNTIME_MAX_MAILBOX_DEPTH << '\n';
+        return -1;
+    }
+    if (sched_policy < RUNTIME_SCHED_GRAPH || sched_policy >= RUNTIME_SCHED_POLICY_COUNT) {
+        std::cerr << "Error: unknown sched_policy " << sched_policy << '\n';
+        return -1;
+    }
+    if (sched_group_size < 0) {
+        std::cerr << "Error: sched_group_size (" << sched_group_size << ") must not be negative\n";
+        return -1;
+    }
+
     // Ensure device is initialized (lazy initialization)
     int rc = ensure_device_initialized(device_id, aicpu_so_binary, aicore_kernel_binary);
     if (rc != 0) {
@@ -260,10 +552,19 @@ int DeviceRunner::run(Runtime& runtime,
         return -1;
     }
 
-    runtime.worker_count = num_ai_core;
-    worker_count_ = num_ai_core;  // Store for print_handshake_results in destructor
     runtime.block_dim = block_dim;
     runtime.sche_cpu_num = launch_aicpu_num;
+    runtime.sched_group_size = sched_group_size;
+    runtime.partition = partition;
+    runtime.mailbox_depth = mailbox_depth;
+    runtime.resolve_on_aicore = resolve_on_aicore;
+    runtime.chain_successors = chain_successors;
+    runtime.sched_policy = sched_policy;
+    runtime.rebalance_cores = rebalance_cores;
+    if (runtime.reserve_workers(num_ai_core) != 0) {
+        return -1;
+    }
+    worker_count_ = num_ai_core;  // Store for print_handshake_results in destructor
 
     // Calculate number of AIC cores (1/3 of total)
     int num_aic = block_dim;  // Round up for 1/3
@@ -272,8 +573,12 @@ int DeviceRunner::run(Runtime& runtime,
         runtime.workers[i].aicpu_ready = 0;
         runtime.workers[i].aicore_done = 0;
         runtime.workers[i].control = 0;
-        runtime.workers[i].task = 0;
-        runtime.workers[i].task_status = 0;
+        for (int s = 0; s < RUNTIME_MAX_MAILBOX_DEPTH; s++) {
+            runtime.workers[i].tasks[s] = 0;
+        }
+        runtime.workers[i].post_count = 0;
+        runtime.workers[i].done_count = 0;
+        runtime.workers[i].wake_word = 0;
         // Set core type: first 1/3 are AIC (0), remaining 2/3 are AIV (1)
         runtime.workers[i].core_type = (i < num_aic) ? 0 : 1;
     }
@@ -292,18 +597,160 @@ int DeviceRunner::run(Runtime& runtime,
     }
     std::cout << '\n';
 
-    // Initialize runtime args
+    // Priorities follow the latest cost estimates; the full upload below
+    // carries them and the ranks
+    if (runtime.apply_cost_model(cost_model_) < 0) {
+        return -1;
+    }
+
+    // Initialize runtime args (replaces any previously resident runtime)
+    resident_runtime_ = nullptr;
     rc = kernel_args_.init_runtime_args(runtime, mem_alloc_);
     if (rc != 0) {
         std::cerr << "Error: init_runtime_args failed: " << rc << '\n';
         return rc;
     }
 
+    // The full upload already carries every parameter's current value
+    runtime.clear_param_dirty();
+
+    rc = launch_and_sync(launch_aicpu_num);
+    if (rc != 0) {
+        kernel_args_.finalize_runtime_args();
+        resident_runtime_ = nullptr;
+        return rc;
+    }
+
+    // Keep the device copy resident so replay() can relaunch it
+    resident_runtime_ = &runtime;
+    launch_aicpu_num_ = launch_aicpu_num;
+
+    rc = fold_launch_costs(runtime);
+    if (rc != 0) {
+        return rc;
+    }
+
+    // Note: FinalizeRuntimeArgs is deferred to Finalize() so PrintHandshakeResults can access device data
+
+    return 0;
+}
+
+int DeviceRunner::launch(Runtime& runtime,
+    int partition,
+    int first_block,
+    int block_dim,
+    int device_id,
+    const std::vector<uint8_t>& aicpu_so_binary,
+    const std::vector<uint8_t>& aicore_kernel_binary,
+    int launch_aicpu_num,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size) {
+    int device_blocks = RUNTIME_MAX_WORKER / cores_per_blockdim_;
+    if (first_block < 0 || block_dim < 1 || first_block + block_dim > device_blocks) {
+        std::cerr << "Error: blocks [" << first_block << ", " << first_block + block_dim << ") are not on the device ("
+                  << device_blocks << " blocks)\n";
+        return -1;
+    }
+    if (in_flight(runtime)) {
+        std::cerr << "Error: Runtime is still in flight; wait for it before launching it again\n";
+        return -1;
+    }
+
+    // Launches complete in order on the runner's streams, so the partition
+    // is free again by the time the next one starts
+    pending_results_[&runtime] = run(runtime, block_dim, device_id, aicpu_so_binary, aicore_kernel_binary,
+        launch_aicpu_num, mailbox_depth, resolve_on_aicore, chain_successors, sched_policy, rebalance_cores,
+        sched_group_size, partition);
+    return 0;
+}
+
+int DeviceRunner::launch_replay(Runtime& runtime) {
+    if (in_flight(runtime)) {
+        std::cerr << "Error: Runtime is still in flight; wait for it before replaying it\n";
+        return -1;
+    }
+    pending_results_[&runtime] = replay(runtime);
+    return 0;
+}
+
+int DeviceRunner::wait(Runtime& runtime) {
+    auto it = pending_results_.find(&runtime);
+    if (it == pending_results_.end()) {
+        std::cerr << "Error: Runtime is not in flight\n";
+        return -1;
+    }
+    int rc = it->second;
+    pending_results_.erase(it);
+    return rc;
+}
+
+bool DeviceRunner::in_flight(const Runtime& runtime) const {
+    return pending_results_.count(&runtime) != 0;
+}
+
+int DeviceRunner::replay(Runtime& runtime) {
+    if (resident_runtime_ != &runtime || kernel_args_.args.runtime_args == nullptr) {
+        std::cerr << "Error: Runtime is not resident on device; call launch_runtime() before replay\n";
+        return -1;
+    }
+
+    // Patch rebound parameters into the resident task block
+    int rc = kernel_args_.upload_dirty_params(runtime);
+    if (rc != 0) {
+        return rc;
+    }
+    runtime.clear_param_dirty();
+
+    int ranks_changed = runtime.apply_cost_model(cost_model_);
+    if (ranks_changed < 0) {
+        return -1;
+    }
+    rc = kernel_args_.upload_cost_model(runtime, ranks_changed != 0);
+    if (rc != 0) {
+        return rc;
+    }
+
+    // The graph, edges and fanin snapshot stay on device; the AICPU restores
+    // fanin at init. Only the handshake buffers need a fresh state.
+    size_t workers_size = sizeof(Handshake) * worker_count_;
+    rc = rtMemcpy(kernel_args_.workers_dev_, workers_size, runtime.workers, workers_size, RT_MEMCPY_HOST_TO_DEVICE);
+    if (rc != 0) {
+        std::cerr << "Error: rtMemcpy for handshake reset failed: " << rc << '\n';
+        return rc;
+    }
+
+    rc = launch_and_sync(launch_aicpu_num_);
+    if (rc != 0) {
+        return rc;
+    }
+    return fold_launch_costs(runtime);
+}
+
+int DeviceRunner::fold_launch_costs(Runtime& runtime) {
+    int rc = kernel_args_.download_func_samples(runtime);
+    if (rc != 0) {
+        return rc;
+    }
+    runtime.fold_func_samples(cost_model_);
+    return 0;
+}
+
+void DeviceRunner::release_runtime(const Runtime& runtime) {
+    pending_results_.erase(&runtime);
+    if (resident_runtime_ == &runtime) {
+        resident_runtime_ = nullptr;
+    }
+}
+
+int DeviceRunner::launch_and_sync(int launch_aicpu_num) {
     // Launch AICPU init kernel
-    rc = launch_aicpu_kernel(stream_aicpu_, &kernel_args_.args, "DynTileFwkKernelServerInit", 1);
+    int rc = launch_aicpu_kernel(stream_aicpu_, &kernel_args_.args, "DynTileFwkKernelServerInit", 1);
     if (rc != 0) {
         std::cerr << "Error: launch_aicpu_kernel (init) failed: " << rc << '\n';
-        kernel_args_.finalize_runtime_args();
         return rc;
     }
 
@@ -311,7 +758,6 @@ int DeviceRunner::run(Runtime& runtime,
     rc = launch_aicpu_kernel(stream_aicpu_, &kernel_args_.args, "DynTileFwkKernelServer", launch_aicpu_num);
     if (rc != 0) {
         std::cerr << "Error: launch_aicpu_kernel (main) failed: " << rc << '\n';
-        kernel_args_.finalize_runtime_args();
         return rc;
     }
 
@@ -319,7 +765,6 @@ int DeviceRunner::run(Runtime& runtime,
     rc = launch_aicore_kernel(stream_aicore_, kernel_args_.args.runtime_args);
     if (rc != 0) {
         std::cerr << "Error: launch_aicore_kernel failed: " << rc << '\n';
-        kernel_args_.finalize_runtime_args();
         return rc;
     }
 
@@ -327,37 +772,32 @@ int DeviceRunner::run(Runtime& runtime,
     rc = rtStreamSynchronize(stream_aicpu_);
     if (rc != 0) {
         std::cerr << "Error: rtStreamSynchronize (AICPU) failed: " << rc << '\n';
-        kernel_args_.finalize_runtime_args();
         return rc;
     }
 
     rc = rtStreamSynchronize(stream_aicore_);
     if (rc != 0) {
         std::cerr << "Error: rtStreamSynchronize (AICore) failed: " << rc << '\n';
-        kernel_args_.finalize_runtime_args();
         return rc;
     }
-
-    // Note: FinalizeRuntimeArgs is deferred to Finalize() so PrintHandshakeResults can access device data
-
     return 0;
 }
 
 void DeviceRunner::print_handshake_results() {
-    if (stream_aicpu_ == nullptr || worker_count_ == 0 || kernel_args_.args.runtime_args == nullptr) {
+    if (stream_aicpu_ == nullptr || worker_count_ == 0 || kernel_args_.workers_dev_ == nullptr) {
         return;
     }
 
     // Allocate temporary buffer to read handshake data from device
     std::vector<Handshake> workers(worker_count_);
     size_t total_size = sizeof(Handshake) * worker_count_;
-    rtMemcpy(workers.data(), total_size, kernel_args_.args.runtime_args->workers, total_size, RT_MEMCPY_DEVICE_TO_HOST);
+    rtMemcpy(workers.data(), total_size, kernel_args_.workers_dev_, total_size, RT_MEMCPY_DEVICE_TO_HOST);
 
     std::cout << "Handshake results for " << worker_count_ << " cores:" << std::endl;
     for (int i = 0; i < worker_count_; i++) {
         std::cout << "  Core " << i << ": aicore_done=" << workers[i].aicore_done
                   << " aicpu_ready=" << workers[i].aicpu_ready << " control=" << workers[i].control
-                  << " task=" << workers[i].task << std::endl;
+                  << " posted=" << workers[i].post_count << " done=" << workers[i].done_count << std::endl;
     }
 }
 
@@ -397,6 +837,7 @@ int DeviceRunner::finalize() {
 
     device_id_ = -1;
     worker_count_ = 0;
+    resident_runtime_ = nullptr;
     aicore_kernel_binary_.clear();
 
     std::cout << "DeviceRunner finalized\n";
@@ -53,6 +53,14 @@ struct DeviceArgs {
 struct KernelArgsHelper {
     KernelArgs args;
     MemoryAllocator* allocator_{nullptr};
+    void* fanout_edges_dev_{nullptr};    // Device copy of Runtime::fanout_edges
+    void* fanin_snapshot_dev_{nullptr};  // Device copy of Runtime::fanin_snapshot
+    void* task_ranks_dev_{nullptr};      // Device copy of Runtime::task_ranks
+    void* chain_next_dev_{nullptr};      // Device copy of Runtime::chain_next
+    void* resolved_ids_dev_{nullptr};    // Device slots of the resolved queue
+    void* task_block_dev_{nullptr};      // Device copy of all Runtime task chunks
+    void* workers_dev_{nullptr};         // Device copy of Runtime::workers
+    void* doorbells_dev_{nullptr};       // Device words of Runtime::doorbells
 
     /**
      * Initialize device arguments by allocating device memory and copying data
@@ -73,6 +81,11 @@ struct KernelArgsHelper {
     /**
      * Initialize runtime arguments by allocating device memory and copying data
      *
+     * Also uploads the handshake buffers, the packed fanout edge array,
+     * the fanin snapshot, the task ranks and the task chunks (as one
+     * contiguous block), allocates the doorbell words, and rewrites the
+     * device Runtime's pointers and task_chunks table to the device copies.
+     *
      * @param host_runtime  Host-side runtime to copy to device
      * @param allocator  Memory allocator to use
      * @return 0 on success, error code on failure
@@ -86,6 +99,51 @@ struct KernelArgsHelper {
      */
     int finalize_runtime_args();
 
+    /**
+     * Patch the argument words of every dirty graph parameter in the
+     * resident device task block
+     *
+     * Words that are adjacent in both host and device memory (e.g.
+     * consecutive arguments of one task) are coalesced into one copy, so
+     * the upload is proportional to the rebound words, not the graph.
+     *
+     * @param host_runtime  Host runtime holding the patched task payloads
+     * @return 0 on success, error code on failure
+     */
+    int upload_dirty_params(const Runtime& host_runtime);
+
+    /**
+     * Update the resident device runtime's cost model estimates and, if
+     * they changed the task ranks, the device copy of the ranks
+     *
+     * @param host_runtime   Host runtime after Runtime::apply_cost_model()
+     * @param ranks_changed  true if apply_cost_model() recomputed the ranks
+     * @return 0 on success, error code on failure
+     */
+    int upload_cost_model(const Runtime& host_runtime, bool ranks_changed);
+
+    /**
+     * Copy the task durations measured by the last launch
+     * (Runtime::func_samples) from the device runtime to the host one
+     *
+     * @param host_runtime  Host runtime to receive the samples
+     * @return 0 on success, error code on failure
+     */
+    int download_func_samples(Runtime& host_runtime);
+
+    /**
+     * Upload a host int array into a fresh device buffer and store the
+     * buffer's address in a pointer field of the device Runtime
+     *
+     * @param dev_buf    Device buffer slot (previous buffer is freed)
+     * @param host_data  Host array to copy (may be null if size is 0)
+     * @param size       Array size in bytes
+     * @param dev_field  Address of the pointer field in the device Runtime
+     * @param name       Array name for error messages
+     * @return 0 on success, error code on failure
+     */
+    int upload_int_array(void** dev_buf, const int* host_data, size_t size, int** dev_field, const char* name);
+
     /**
      * Implicit conversion operators for seamless use with runtime APIs
      *
@@ -201,6 +259,19 @@ public:
      * @param aicpu_so_binary       Binary data of AICPU shared object
      * @param aicore_kernel_binary  Binary data of AICore kernel
      * @param launch_aicpu_num      Number of AICPU instances (default: 1)
+     * @param mailbox_depth         Tasks in flight per core (default: 1)
+     * @param resolve_on_aicore     1 to resolve dependencies on the AICores
+     *                              (default: 0, on the AICPU)
+     * @param chain_successors      1 to let cores run chain successors
+     *                              without an AICPU round trip (default: 0)
+     * @param sched_policy          AICPU scheduling policy, RUNTIME_SCHED_*
+     *                              (default: the orchestration's choice)
+     * @param rebalance_cores       1 to move idle blocks between AICPU
+     *                              threads by load (default: 0)
+     * @param sched_group_size      AICPU threads per coordinator group
+     *                              (default: 0, one flat group)
+     * @param partition             AICPU executor instance to schedule on
+     *                              (default: 0, see launch())
      * @return 0 on success, error code on failure
      */
     int run(Runtime& runtime,
@@ -208,7 +279,97 @@ public:
         int device_id,
         const std::vector<uint8_t>& aicpu_so_binary,
         const std::vector<uint8_t>& aicore_kernel_binary,
-        int launch_aicpu_num = 1);
+        int launch_aicpu_num = 1,
+        int mailbox_depth = 1,
+        int resolve_on_aicore = 0,
+        int chain_successors = 0,
+        int sched_policy = RUNTIME_SCHED_GRAPH,
+        int rebalance_cores = 0,
+        int sched_group_size = 0,
+        int partition = 0);
+
+    /**
+     * Execute a runtime on a core partition
+     *
+     * Partition-aware entry of the C API's asynchronous launch: validates
+     * that blocks [first_block, first_block + block_dim) exist on the
+     * device and runs the runtime on the partition's AICPU executor
+     * instance. This runner keeps a single graph resident and launches on
+     * one pair of streams, so the launch completes before launch()
+     * returns; its result is kept for wait().
+     *
+     * @param runtime      Runtime to execute
+     * @param partition    Partition index (0..RUNTIME_MAX_PARTITIONS-1)
+     * @param first_block  First device block of the partition
+     * @return 0 if the launch was accepted, -1 on invalid arguments
+     *
+     * The remaining parameters are those of run().
+     */
+    int launch(Runtime& runtime,
+        int partition,
+        int first_block,
+        int block_dim,
+        int device_id,
+        const std::vector<uint8_t>& aicpu_so_binary,
+        const std::vector<uint8_t>& aicore_kernel_binary,
+        int launch_aicpu_num = 1,
+        int mailbox_depth = 1,
+        int resolve_on_aicore = 0,
+        int chain_successors = 0,
+        int sched_policy = RUNTIME_SCHED_GRAPH,
+        int rebalance_cores = 0,
+        int sched_group_size = 0);
+
+    /**
+     * Relaunch the runtime most recently executed by run()
+     *
+     * The device copy of the graph stays resident after run(), so replay
+     * only resets the handshake buffers on device and launches the kernels
+     * again with the same launch settings (block_dim, AICPU thread count,
+     * mailbox depth, resolution mode, chaining). Fanin counts are restored
+     * on device from the graph's fanin snapshot. Parameters rebound with
+     * Runtime::set_param() since the last launch are patched into the
+     * device task block first (dirty words only), and so are the cost
+     * model estimates (and the task ranks if they moved).
+     *
+     * @param runtime  Runtime previously passed to run()
+     * @return 0 on success, error code on failure
+     */
+    int replay(Runtime& runtime);
+
+    /**
+     * Replay a runtime for wait(); completes before returning, like
+     * launch()
+     *
+     * @param runtime  Runtime previously passed to run()
+     * @return 0 if the replay was accepted, -1 if a result of runtime is
+     *         still waiting to be collected
+     */
+    int launch_replay(Runtime& runtime);
+
+    /**
+     * Collect the result of launch() or launch_replay()
+     *
+     * @param runtime  Runtime passed to launch() or launch_replay()
+     * @return Result of the launch, -1 if none is pending
+     */
+    int wait(Runtime& runtime);
+
+    /**
+     * Whether a result of launch() or launch_replay() is pending for runtime
+     */
+    bool in_flight(const Runtime& runtime) const;
+
+    /**
+     * Drop the resident device copy of a runtime from replay
+     *
+     * Called when the runtime is finalized so a later replay of the same
+     * address fails instead of running a stale graph. Also drops a launch
+     * result not collected by wait().
+     *
+     * @param runtime  Runtime being finalized
+     */
+    void release_runtime(const Runtime& runtime);
 
     /**
      * Print handshake results from device
@@ -281,6 +442,18 @@ public:
      */
     uint64_t get_function_bin_addr(int func_id);
 
+    /**
+     * Online cost model: per-func_id task duration estimates, indexed by
+     * func_id (RUNTIME_MAX_FUNC_ID entries). Every launch and replay
+     * installs it into the runtime first (Runtime::apply_cost_model()) and
+     * folds the durations measured on device into it afterwards. The table
+     * outlives finalize(), so later runtimes in the process start from it;
+     * the C API exports and pre-seeds it.
+     *
+     * @return Pointer to the table
+     */
+    FuncCost* cost_model() { return cost_model_; }
+
     /**
      * Ensure device is set and streams are created (minimal initialization)
      *
@@ -303,6 +476,8 @@ private:
     int block_dim_{0};
     int cores_per_blockdim_{3};
     int worker_count_{0};  // Stored for print_handshake_results in destructor
+    int launch_aicpu_num_{1};
+    const Runtime* resident_runtime_{nullptr};  // Runtime whose device copy replay() relaunches
     std::vector<uint8_t> aicore_kernel_binary_;
 
     // Memory management
@@ -319,6 +494,30 @@ private:
     bool binaries_loaded_{false};            // true after AICPU SO loaded
     std::map<int, uint64_t> func_id_to_addr_;  // func_id -> function_bin_addr (device GM)
 
+    // Cost model estimates per func_id (see cost_model())
+    FuncCost cost_model_[RUNTIME_MAX_FUNC_ID]{};
+
+    // Results of launch() and launch_replay() not yet collected by wait()
+    std::map<const Runtime*, int> pending_results_;
+
+    /**
+     * Fold the durations measured by the launch that just finished into
+     * the cost model
+     *
+     * @param runtime  Host runtime of the launch
+     * @return 0 on success, error code on failure
+     */
+    int fold_launch_costs(Runtime& runtime);
+
+    /**
+     * Launch the AICPU init, AICPU main and AICore kernels on the resident
+     * runtime args and wait for both streams
+     *
+     * @param launch_aicpu_num  Number of AICPU instances
+     * @return 0 on success, error code on failure
+     */
+    int launch_and_sync(int launch_aicpu_num);
+
     /**
      * Ensure device is initialized (lazy initialization)
      *
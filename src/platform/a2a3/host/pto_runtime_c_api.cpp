@@ -67,6 +67,9 @@ int init_runtime(RuntimeHandle runtime,
         r->host_api.copy_to_device = copy_to_device;
         r->host_api.copy_from_device = copy_from_device;
 
+        // Measured kernel costs, for orchestration and rank computation
+        r->apply_cost_model(DeviceRunner::get().cost_model());
+
         // Delegate SO loading and orchestration to init_runtime_impl
         return init_runtime_impl(r, orch_so_binary, orch_so_size,
                                orch_func_name, func_args, func_args_count);
@@ -133,7 +136,13 @@ int launch_runtime(RuntimeHandle runtime,
     const uint8_t* aicpu_binary,
     size_t aicpu_size,
     const uint8_t* aicore_binary,
-    size_t aicore_size) {
+    size_t aicore_size,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size) {
     if (runtime == NULL) {
         return -1;
     }
@@ -149,19 +158,178 @@ int launch_runtime(RuntimeHandle runtime,
 
         // Run the runtime (device initialization is handled internally)
         Runtime* r = static_cast<Runtime*>(runtime);
-        return runner.run(*r, block_dim, device_id, aicpu_vec, aicore_vec, aicpu_thread_num);
+        return runner.run(*r, block_dim, device_id, aicpu_vec, aicore_vec, aicpu_thread_num, mailbox_depth,
+            resolve_on_aicore, chain_successors, sched_policy, rebalance_cores, sched_group_size);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int launch_runtime_async(RuntimeHandle runtime,
+    int partition,
+    int first_block,
+    int aicpu_thread_num,
+    int block_dim,
+    int device_id,
+    const uint8_t* aicpu_binary,
+    size_t aicpu_size,
+    const uint8_t* aicore_binary,
+    size_t aicore_size,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size) {
+    if (runtime == NULL) {
+        return -1;
+    }
+    if (aicpu_binary == NULL || aicpu_size == 0 || aicore_binary == NULL || aicore_size == 0) {
+        return -1;
+    }
+    try {
+        DeviceRunner& runner = DeviceRunner::get();
+
+        std::vector<uint8_t> aicpu_vec(aicpu_binary, aicpu_binary + aicpu_size);
+        std::vector<uint8_t> aicore_vec(aicore_binary, aicore_binary + aicore_size);
+
+        Runtime* r = static_cast<Runtime*>(runtime);
+        return runner.launch(*r, partition, first_block, block_dim, device_id, aicpu_vec, aicore_vec,
+            aicpu_thread_num, mailbox_depth, resolve_on_aicore, chain_successors, sched_policy, rebalance_cores,
+            sched_group_size);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int replay_runtime(RuntimeHandle runtime) {
+    if (runtime == NULL) {
+        return -1;
+    }
+    try {
+        DeviceRunner& runner = DeviceRunner::get();
+        Runtime* r = static_cast<Runtime*>(runtime);
+        return runner.replay(*r);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int replay_runtime_async(RuntimeHandle runtime) {
+    if (runtime == NULL) {
+        return -1;
+    }
+    try {
+        DeviceRunner& runner = DeviceRunner::get();
+        Runtime* r = static_cast<Runtime*>(runtime);
+        return runner.launch_replay(*r);
     } catch (...) {
         return -1;
     }
 }
 
+int wait_runtime(RuntimeHandle runtime) {
+    if (runtime == NULL) {
+        return -1;
+    }
+    try {
+        DeviceRunner& runner = DeviceRunner::get();
+        Runtime* r = static_cast<Runtime*>(runtime);
+        return runner.wait(*r);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int set_runtime_param(RuntimeHandle runtime, const char* name, uint64_t value) {
+    if (runtime == NULL || name == NULL) {
+        return -1;
+    }
+    try {
+        Runtime* r = static_cast<Runtime*>(runtime);
+        if (DeviceRunner::get().in_flight(*r)) {
+            std::cerr << "Error: Runtime is still in flight; wait for it before setting " << name << '\n';
+            return -1;
+        }
+        return r->set_param(name, value) < 0 ? -1 : 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int get_cost_model(uint64_t* samples, double* mean, double* var, int capacity) {
+    if (capacity < 0) {
+        return -1;
+    }
+    try {
+        const FuncCost* model = DeviceRunner::get().cost_model();
+        for (int f = 0; f < capacity && f < RUNTIME_MAX_FUNC_ID; f++) {
+            if (samples != NULL) {
+                samples[f] = model[f].samples;
+            }
+            if (mean != NULL) {
+                mean[f] = model[f].mean;
+            }
+            if (var != NULL) {
+                var[f] = model[f].var;
+            }
+        }
+        return RUNTIME_MAX_FUNC_ID;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int set_cost_model(const uint64_t* samples, const double* mean, const double* var, int count) {
+    if (samples == NULL || mean == NULL || var == NULL || count < 0 || count > RUNTIME_MAX_FUNC_ID) {
+        return -1;
+    }
+    for (int f = 0; f < count; f++) {
+        if (!(mean[f] >= 0.0) || !(var[f] >= 0.0)) {
+            std::cerr << "Error: Invalid cost estimate for func_id " << f << '\n';
+            return -1;
+        }
+    }
+    try {
+        FuncCost* model = DeviceRunner::get().cost_model();
+        for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+            model[f] = f < count ? FuncCost{samples[f], mean[f], var[f]} : FuncCost{};
+        }
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int set_idle_wait(int mode, int spin_polls, int yield_polls) {
+    // Cores and AICPU threads poll on hardware in every mode
+    if (mode < RUNTIME_WAIT_SPIN || mode >= RUNTIME_WAIT_MODE_COUNT || spin_polls < 0 || yield_polls < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int set_core_backend(int backend, int host_threads) {
+    // AICores are hardware; only the thread backend (0) applies
+    if (backend != 0 || host_threads < 0) {
+        return -1;
+    }
+    return 0;
+}
+
 int finalize_runtime(RuntimeHandle runtime) {
     if (runtime == NULL) {
         return -1;
     }
     try {
         Runtime* r = static_cast<Runtime*>(runtime);
-        int rc = validate_runtime_impl(r);
+        DeviceRunner& runner = DeviceRunner::get();
+        int rc = runner.in_flight(*r) ? runner.wait(*r) : 0;
+        int validate_rc = validate_runtime_impl(r);
+        if (rc == 0) {
+            rc = validate_rc;
+        }
+        runner.release_runtime(*r);
         // Call destructor (user will call free())
         r->~Runtime();
         return rc;
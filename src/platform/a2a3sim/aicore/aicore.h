@@ -34,4 +34,94 @@
 #define CACHELINE_OUT 0
 #define dcci(addr, mode, opt) ((void)0)
 
+// Fiber the calling simulated core runs on (fiber backend, see
+// sim_fiber.h), null on the thread backend. Set by the fiber entry point in
+// kernel.cpp and restored by the fiber itself whenever it resumes.
+#include <sched.h>
+#include "sim_fiber.h"
+extern thread_local SimFiber* g_sim_fiber;
+
+static inline void aicore_fiber_switch(SimFiber* fiber, bool idle) {
+    sim_fiber_switch(fiber, idle);
+    g_sim_fiber = fiber;
+}
+
+// Waiting on another simulated core (e.g. at a MIX gang barrier) gives the
+// host CPU away: simulated cores may outnumber host CPUs, and the core
+// waited on may be the one that needs it. A fiber yields to its host
+// thread's other fibers instead.
+static inline void aicore_spin_pause() {
+    SimFiber* fiber = g_sim_fiber;
+    if (fiber != nullptr) {
+        aicore_fiber_switch(fiber, true);
+    } else {
+        sched_yield();
+    }
+}
+
+// Yield point of a spinning handshake poll: switches to the next fiber of
+// the host thread on the fiber backend, no-op on the thread backend.
+// idle = nothing happened since the previous poll either.
+static inline void aicore_fiber_poll(bool idle) {
+    SimFiber* fiber = g_sim_fiber;
+    if (fiber != nullptr) {
+        aicore_fiber_switch(fiber, idle);
+    }
+}
+
+// Enter and leave the kernels of a MIX task (fiber backend: take and
+// release the launch's gang lock, see sim_fiber.h)
+static inline void aicore_gang_begin(int task_id) {
+    SimFiber* fiber = g_sim_fiber;
+    if (fiber == nullptr) {
+        return;
+    }
+    while (true) {
+        int owner = fiber->gang->task.load(std::memory_order_acquire);
+        if (owner == task_id) {
+            return;
+        }
+        if (owner < 0 && fiber->gang->task.compare_exchange_weak(owner, task_id, std::memory_order_acq_rel)) {
+            return;
+        }
+        aicore_fiber_switch(fiber, true);
+    }
+}
+
+static inline void aicore_gang_end(int members) {
+    SimFiber* fiber = g_sim_fiber;
+    if (fiber != nullptr && fiber->gang->left.fetch_add(1, std::memory_order_acq_rel) + 1 == members) {
+        fiber->gang->left.store(0, std::memory_order_relaxed);
+        fiber->gang->task.store(-1, std::memory_order_release);
+    }
+}
+
+// Blocking idle waits on a Handshake or Runtime wake word
+// (RUNTIME_WAIT_BLOCK, see sim_wait.h)
+#include "sim_wait.h"
+#define aicore_wait_arm(word) sim_wait_arm(word)
+#define aicore_wake(word) sim_wake(word)
+
+// A fiber blocks by parking until its host thread sees the word change
+static inline void aicore_wait_block(volatile uint32_t* word, uint32_t armed) {
+    SimFiber* fiber = g_sim_fiber;
+    if (fiber == nullptr) {
+        sim_wait_block(word, armed);
+        return;
+    }
+    fiber->wait_word = word;
+    fiber->wait_armed = armed;
+    aicore_fiber_switch(fiber, true);
+    fiber->wait_word = nullptr;
+}
+
+// Device timer for task start/end stamps: nanoseconds on the host's
+// monotonic clock
+#include <chrono>
+#include <cstdint>
+static inline uint64_t aicore_clock() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 #endif  // AICORE_SIM_H
@@ -11,7 +11,16 @@
 // Declare the original function (defined in aicore_executor.cpp with weak linkage)
 void aicore_execute(__gm__ Runtime* runtime, int block_idx, int core_type);
 
+thread_local SimFiber* g_sim_fiber = nullptr;
+
 // Wrapper with extern "C" for dlsym lookup
 extern "C" void aicore_execute_wrapper(__gm__ Runtime* runtime, int block_idx, int core_type) {
     aicore_execute(runtime, block_idx, core_type);
 }
+
+// Entry point of a simulated core on the fiber backend, called on the fiber
+extern "C" void aicore_execute_fiber(__gm__ Runtime* runtime, int block_idx, int core_type, SimFiber* fiber) {
+    g_sim_fiber = fiber;
+    aicore_execute(runtime, block_idx, core_type);
+    g_sim_fiber = nullptr;
+}
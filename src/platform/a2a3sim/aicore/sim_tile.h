@@ -0,0 +1,206 @@
+/**
+ * Vector Tile Helpers for Simulation Kernels
+ *
+ * Header-only element-wise float32 operations for sim kernels, with an
+ * explicit SIMD path chosen at compile time from the target flags that
+ * PTOCompiler.compile_incore_sim() passes for the selected ISA:
+ *
+ *   AVX-512F (16 lanes), AVX2 (8), SSE2 (4, x86-64 baseline),
+ *   NEON (4, AArch64 baseline), or scalar (SIM_TILE_SCALAR or no SIMD)
+ *
+ * Only the kernel's .text section is loaded, so everything here is forced
+ * inline and uses no constants from memory: a kernel built on it is still
+ * a single self-contained function.
+ *
+ * Example:
+ *     extern "C" void kernel_add(int64_t* args) {
+ *         sim_tile::add(reinterpret_cast<float*>(args[2]), reinterpret_cast<float*>(args[0]),
+ *                       reinterpret_cast<float*>(args[1]), args[3]);
+ *     }
+ */
+
+#ifndef SIM_TILE_H
+#define SIM_TILE_H
+
+#include <cstdint>
+
+#if defined(SIM_TILE_SCALAR)
+#define SIM_TILE_ISA_SCALAR
+#elif defined(__AVX512F__)
+#include <immintrin.h>
+#define SIM_TILE_ISA_AVX512
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SIM_TILE_ISA_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIM_TILE_ISA_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SIM_TILE_ISA_NEON
+#else
+#define SIM_TILE_ISA_SCALAR
+#endif
+
+#define SIM_TILE_INLINE inline __attribute__((always_inline))
+
+namespace sim_tile {
+
+// =============================================================================
+// Vector of float32 lanes for the selected ISA
+// =============================================================================
+
+#if defined(SIM_TILE_ISA_AVX512)
+constexpr int LANES = 16;
+struct Vec {
+    __m512 v;
+};
+SIM_TILE_INLINE Vec load(const float* p) { return {_mm512_loadu_ps(p)}; }
+SIM_TILE_INLINE void store(float* p, Vec a) { _mm512_storeu_ps(p, a.v); }
+SIM_TILE_INLINE Vec splat(float s) { return {_mm512_set1_ps(s)}; }
+SIM_TILE_INLINE Vec add(Vec a, Vec b) { return {_mm512_add_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec sub(Vec a, Vec b) { return {_mm512_sub_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec mul(Vec a, Vec b) { return {_mm512_mul_ps(a.v, b.v)}; }
+#elif defined(SIM_TILE_ISA_AVX2)
+constexpr int LANES = 8;
+struct Vec {
+    __m256 v;
+};
+SIM_TILE_INLINE Vec load(const float* p) { return {_mm256_loadu_ps(p)}; }
+SIM_TILE_INLINE void store(float* p, Vec a) { _mm256_storeu_ps(p, a.v); }
+SIM_TILE_INLINE Vec splat(float s) { return {_mm256_set1_ps(s)}; }
+SIM_TILE_INLINE Vec add(Vec a, Vec b) { return {_mm256_add_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec sub(Vec a, Vec b) { return {_mm256_sub_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec mul(Vec a, Vec b) { return {_mm256_mul_ps(a.v, b.v)}; }
+#elif defined(SIM_TILE_ISA_SSE2)
+constexpr int LANES = 4;
+struct Vec {
+    __m128 v;
+};
+SIM_TILE_INLINE Vec load(const float* p) { return {_mm_loadu_ps(p)}; }
+SIM_TILE_INLINE void store(float* p, Vec a) { _mm_storeu_ps(p, a.v); }
+SIM_TILE_INLINE Vec splat(float s) { return {_mm_set1_ps(s)}; }
+SIM_TILE_INLINE Vec add(Vec a, Vec b) { return {_mm_add_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec sub(Vec a, Vec b) { return {_mm_sub_ps(a.v, b.v)}; }
+SIM_TILE_INLINE Vec mul(Vec a, Vec b) { return {_mm_mul_ps(a.v, b.v)}; }
+#elif defined(SIM_TILE_ISA_NEON)
+constexpr int LANES = 4;
+struct Vec {
+    float32x4_t v;
+};
+SIM_TILE_INLINE Vec load(const float* p) { return {vld1q_f32(p)}; }
+SIM_TILE_INLINE void store(float* p, Vec a) { vst1q_f32(p, a.v); }
+SIM_TILE_INLINE Vec splat(float s) { return {vdupq_n_f32(s)}; }
+SIM_TILE_INLINE Vec add(Vec a, Vec b) { return {vaddq_f32(a.v, b.v)}; }
+SIM_TILE_INLINE Vec sub(Vec a, Vec b) { return {vsubq_f32(a.v, b.v)}; }
+SIM_TILE_INLINE Vec mul(Vec a, Vec b) { return {vmulq_f32(a.v, b.v)}; }
+#else
+constexpr int LANES = 1;
+struct Vec {
+    float v;
+};
+SIM_TILE_INLINE Vec load(const float* p) { return {*p}; }
+SIM_TILE_INLINE void store(float* p, Vec a) { *p = a.v; }
+SIM_TILE_INLINE Vec splat(float s) { return {s}; }
+SIM_TILE_INLINE Vec add(Vec a, Vec b) { return {a.v + b.v}; }
+SIM_TILE_INLINE Vec sub(Vec a, Vec b) { return {a.v - b.v}; }
+SIM_TILE_INLINE Vec mul(Vec a, Vec b) { return {a.v * b.v}; }
+#endif
+
+// =============================================================================
+// Element-wise loops
+// =============================================================================
+
+// Operations, each on vectors and on the scalar tail elements
+struct AddOp {
+    static SIM_TILE_INLINE Vec apply(Vec a, Vec b) { return add(a, b); }
+    static SIM_TILE_INLINE float apply(float a, float b) { return a + b; }
+};
+struct SubOp {
+    static SIM_TILE_INLINE Vec apply(Vec a, Vec b) { return sub(a, b); }
+    static SIM_TILE_INLINE float apply(float a, float b) { return a - b; }
+};
+struct MulOp {
+    static SIM_TILE_INLINE Vec apply(Vec a, Vec b) { return mul(a, b); }
+    static SIM_TILE_INLINE float apply(float a, float b) { return a * b; }
+};
+
+/**
+ * out[i] = Op(a[i], b[i]) for i in [0, n)
+ *
+ * Four vectors per iteration, then single vectors, then the remaining
+ * elements one by one (a masked vector on AVX-512). out may alias a or b.
+ */
+template <typename Op>
+SIM_TILE_INLINE void map(float* out, const float* a, const float* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 4 * LANES <= n; i += 4 * LANES) {
+        Vec r0 = Op::apply(load(a + i), load(b + i));
+        Vec r1 = Op::apply(load(a + i + LANES), load(b + i + LANES));
+        Vec r2 = Op::apply(load(a + i + 2 * LANES), load(b + i + 2 * LANES));
+        Vec r3 = Op::apply(load(a + i + 3 * LANES), load(b + i + 3 * LANES));
+        store(out + i, r0);
+        store(out + i + LANES, r1);
+        store(out + i + 2 * LANES, r2);
+        store(out + i + 3 * LANES, r3);
+    }
+    for (; i + LANES <= n; i += LANES) {
+        store(out + i, Op::apply(load(a + i), load(b + i)));
+    }
+#if defined(SIM_TILE_ISA_AVX512)
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        __m512 r = Op::apply(Vec{_mm512_maskz_loadu_ps(mask, a + i)}, Vec{_mm512_maskz_loadu_ps(mask, b + i)}).v;
+        _mm512_mask_storeu_ps(out + i, mask, r);
+    }
+#else
+    for (; i < n; i++) {
+        out[i] = Op::apply(a[i], b[i]);
+    }
+#endif
+}
+
+/**
+ * out[i] = Op(a[i], s) for i in [0, n)
+ */
+template <typename Op>
+SIM_TILE_INLINE void map_scalar(float* out, const float* a, float s, int64_t n) {
+    Vec vs = splat(s);
+    int64_t i = 0;
+    for (; i + 4 * LANES <= n; i += 4 * LANES) {
+        Vec r0 = Op::apply(load(a + i), vs);
+        Vec r1 = Op::apply(load(a + i + LANES), vs);
+        Vec r2 = Op::apply(load(a + i + 2 * LANES), vs);
+        Vec r3 = Op::apply(load(a + i + 3 * LANES), vs);
+        store(out + i, r0);
+        store(out + i + LANES, r1);
+        store(out + i + 2 * LANES, r2);
+        store(out + i + 3 * LANES, r3);
+    }
+    for (; i + LANES <= n; i += LANES) {
+        store(out + i, Op::apply(load(a + i), vs));
+    }
+#if defined(SIM_TILE_ISA_AVX512)
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_ps(out + i, mask, Op::apply(Vec{_mm512_maskz_loadu_ps(mask, a + i)}, vs).v);
+    }
+#else
+    for (; i < n; i++) {
+        out[i] = Op::apply(a[i], s);
+    }
+#endif
+}
+
+// out = a + b, a - b, a * b
+SIM_TILE_INLINE void add(float* out, const float* a, const float* b, int64_t n) { map<AddOp>(out, a, b, n); }
+SIM_TILE_INLINE void sub(float* out, const float* a, const float* b, int64_t n) { map<SubOp>(out, a, b, n); }
+SIM_TILE_INLINE void mul(float* out, const float* a, const float* b, int64_t n) { map<MulOp>(out, a, b, n); }
+
+// out = a + s, a * s
+SIM_TILE_INLINE void adds(float* out, const float* a, float s, int64_t n) { map_scalar<AddOp>(out, a, s, n); }
+SIM_TILE_INLINE void muls(float* out, const float* a, float s, int64_t n) { map_scalar<MulOp>(out, a, s, n); }
+
+}  // namespace sim_tile
+
+#endif  // SIM_TILE_H
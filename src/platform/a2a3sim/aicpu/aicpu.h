@@ -0,0 +1,23 @@
+/**
+ * AICPU Platform Hooks for Simulation
+ *
+ * The scheduler threads are host threads that share host CPUs with the
+ * simulated AICores (and, with several partitions in flight, with other
+ * launches), so an idle scheduler gives its CPU away instead of spinning
+ * through the time slice of the core it waits on.
+ */
+
+#pragma once
+
+#include <sched.h>
+
+#include "sim_wait.h"
+
+// Wait hint for an idle scheduler thread past its spin budget
+#define aicpu_spin_pause() sched_yield()
+
+// Blocking idle waits on a Handshake or Runtime wake word
+// (RUNTIME_WAIT_BLOCK, see sim_wait.h)
+#define aicpu_wait_arm(word) sim_wait_arm(word)
+#define aicpu_wait_block(word, armed) sim_wait_block(word, armed)
+#define aicpu_wake(word) sim_wake(word)
@@ -0,0 +1,58 @@
+/**
+ * Fiber Backend for Simulated AICores
+ *
+ * With the fiber backend (DeviceRunner::set_core_backend()) the AICores of
+ * a launch run as user-space fibers (ucontext) on a few host threads
+ * instead of on one OS thread each, so topologies much larger than the
+ * host run without the OS scheduler juggling one spinning thread per core.
+ *
+ * Every host thread runs its fibers round-robin, and fibers never migrate
+ * between host threads. A fiber gives its host thread up only at yield
+ * points, which sit at the AICore's handshake polls: the idle polls and
+ * the MIX gang barrier reach sim_fiber_switch() through the platform hooks
+ * in aicore.h. Idle waiting follows the launch's mode at host thread
+ * level: a pass over fibers that all only polled yields the host CPU, and
+ * once they all block on their wake words (RUNTIME_WAIT_BLOCK) the host
+ * thread sleeps on all of the words at once.
+ *
+ * MIX kernels wait at their gang barrier inline, without a yield point, so
+ * the three cores of a block are placed on different host threads and a
+ * gang lock admits one gang at a time into its kernels: the members of the
+ * gang holding it never wait for a host thread that is itself stuck in
+ * another gang's barrier.
+ */
+
+#ifndef SIM_FIBER_H
+#define SIM_FIBER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ucontext.h>
+
+// Serializes MIX gangs across the fibers of a launch (see above)
+struct SimFiberGang {
+    std::atomic<int> task{-1};  // MIX task whose gang holds the lock, -1 if free
+    std::atomic<int> left{0};   // Members of that gang done with it
+};
+
+// One simulated AICore running as a fiber
+struct SimFiber {
+    ucontext_t context;     // Saved context while the fiber is parked
+    ucontext_t* host;       // Scheduler context of its host thread
+    SimFiberGang* gang;     // Gang lock of the launch
+    bool idle;              // Last yield found nothing to do
+    volatile uint32_t* wait_word;  // Wake word the fiber blocks on, else null
+    uint32_t wait_armed;    // Its armed value (see sim_wait.h)
+    bool done;              // aicore_execute() returned
+    void* runtime;          // Launch arguments of the fiber
+    int core;
+    int core_type;
+};
+
+// Park the calling fiber and resume its host thread's scheduler
+static inline void sim_fiber_switch(SimFiber* fiber, bool idle) {
+    fiber->idle = idle;
+    swapcontext(&fiber->context, fiber->host);
+}
+
+#endif  // SIM_FIBER_H
@@ -0,0 +1,130 @@
+/**
+ * Blocking Idle Waits for Simulation
+ *
+ * In RUNTIME_WAIT_BLOCK mode an idle simulated core or AICPU thread sleeps
+ * on a 32-bit wake word instead of polling, so simulated cores that
+ * outnumber host CPUs leave them to the threads running kernels.
+ *
+ * Bit 0 of a wake word means a waiter is armed; the upper bits count
+ * wakes. A waiter arms the word (sim_wait_arm()), checks its condition once
+ * more and then sleeps (sim_wait_block()) only while the word still holds
+ * the armed value. A writer stores its data first and then calls
+ * sim_wake(), which bumps the count and enters the kernel only if a waiter
+ * is armed. Either the waiter's re-check sees the data or the writer sees
+ * the armed bit, so no wake is lost. Sleeps are bounded by a timeout all
+ * the same.
+ *
+ * Linux uses futexes; elsewhere a blocked wait degrades to a yield. A fiber
+ * host thread whose fibers all block waits on all their words at once
+ * (sim_wait_block_any(), futex_waitv where the kernel has it).
+ */
+
+#ifndef SIM_WAIT_H
+#define SIM_WAIT_H
+
+#include <cstdint>
+#include <sched.h>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Longest sleep of a blocked wait
+#define SIM_WAIT_TIMEOUT_NS 1000000L
+
+/**
+ * Arm a wake word before the last check of the waited-for condition
+ *
+ * @param word  Wake word
+ * @return Value to pass to sim_wait_block() (never 0)
+ */
+static inline uint32_t sim_wait_arm(volatile uint32_t* word) {
+    return __atomic_fetch_or(word, 1u, __ATOMIC_SEQ_CST) | 1u;
+}
+
+/**
+ * Sleep until the wake word changes from its armed value
+ *
+ * @param word   Wake word
+ * @param armed  Value returned by sim_wait_arm()
+ * @return true if the wait timed out without a wake
+ */
+static inline bool sim_wait_block(volatile uint32_t* word, uint32_t armed) {
+#ifdef __linux__
+    struct timespec timeout = {0, SIM_WAIT_TIMEOUT_NS};
+    long rc = syscall(SYS_futex, const_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, armed, &timeout, nullptr, 0);
+    return rc != 0 && errno == ETIMEDOUT;
+#else
+    (void)word;
+    (void)armed;
+    sched_yield();
+    return false;
+#endif
+}
+
+/**
+ * Sleep until any of several wake words changes from its armed value
+ *
+ * @param words  Wake words
+ * @param armed  Value returned by sim_wait_arm() for each word
+ * @param count  Number of words
+ * @return true if the wait timed out without a wake
+ */
+static inline bool sim_wait_block_any(volatile uint32_t* const* words, const uint32_t* armed, int count) {
+    if (count == 1) {
+        return sim_wait_block(words[0], armed[0]);
+    }
+#if defined(__linux__) && defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+    if (count <= FUTEX_WAITV_MAX) {
+        struct futex_waitv waiters[FUTEX_WAITV_MAX] = {};
+        for (int i = 0; i < count; i++) {
+            waiters[i].val = armed[i];
+            waiters[i].uaddr = reinterpret_cast<uintptr_t>(words[i]);
+            waiters[i].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+        }
+        // The timeout of futex_waitv is absolute
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_nsec += SIM_WAIT_TIMEOUT_NS;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        long rc = syscall(SYS_futex_waitv, waiters, count, 0, &deadline, CLOCK_MONOTONIC);
+        if (rc >= 0 || errno != ENOSYS) {
+            return rc < 0 && errno == ETIMEDOUT;
+        }
+    }
+#else
+    (void)words;
+    (void)armed;
+#endif
+    sched_yield();
+    return false;
+}
+
+/**
+ * Wake every waiter armed on a wake word (call after writing the data)
+ *
+ * @param word  Wake word
+ */
+static inline void sim_wake(volatile uint32_t* word) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint32_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+    while ((value & 1u) != 0) {
+        // Clears the armed bit and carries into the wake count
+        if (__atomic_compare_exchange_n(word, &value, value + 1u, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+#ifdef __linux__
+            syscall(SYS_futex, const_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+            return;
+        }
+    }
+}
+
+#endif  // SIM_WAIT_H
@@ -16,6 +16,8 @@
 
 #include "device_runner.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <dlfcn.h>
@@ -46,11 +48,48 @@
 #endif
 
 #include "runtime.h"
+#include "sim_wait.h"
 
 // Function pointer types for dynamically loaded executors
 typedef int (*aicpu_execute_func_t)(Runtime* runtime);
 typedef void (*aicore_execute_func_t)(Runtime* runtime, int block_idx, int core_type);
 
+// Kernel signatures, called directly by the direct backend (see
+// aicore_executor.cpp and CoreType::MIX)
+typedef void (*UnifiedKernelFunc)(int64_t* args);
+typedef void (*MixKernelFunc)(int64_t* args, int role, uint32_t* barrier);
+
+/**
+ * Idle wait of a direct backend thread after `rounds` fruitless polls
+ *
+ * Follows the launch's set_idle_wait() mode like the AICPU threads: spin
+ * for idle_spin rounds, yield for idle_yield more (from then on in yield
+ * mode), then arm the wake word and, on the next idle round after the
+ * caller checked its condition again, sleep on it.
+ */
+static void direct_idle_wait(const Runtime& runtime, volatile uint32_t* word, int rounds, uint32_t* armed) {
+    if (runtime.idle_wait == RUNTIME_WAIT_SPIN || rounds <= runtime.idle_spin) {
+        return;
+    }
+    if (runtime.idle_wait == RUNTIME_WAIT_YIELD || rounds <= runtime.idle_spin + runtime.idle_yield) {
+        std::this_thread::yield();
+        return;
+    }
+    if (*armed == 0) {
+        *armed = sim_wait_arm(word);
+        return;
+    }
+    sim_wait_block(word, *armed);
+    *armed = 0;
+}
+
+// Stack of one AICore fiber (fiber backend)
+static constexpr size_t SIM_FIBER_STACK_SIZE = 256 * 1024;
+
+// Fiber a host thread is starting; read by DeviceRunner::fiber_main() on
+// its first switch (makecontext() entry points take no pointer argument)
+static thread_local SimFiber* t_starting_fiber = nullptr;
+
 // =============================================================================
 // DeviceRunner Implementation
 // =============================================================================
@@ -126,6 +165,10 @@ int DeviceRunner::ensure_binaries_loaded(const std::vector<uint8_t>& aicpu_so_bi
             return -1;
         }
         std::cout << "DeviceRunner(sim): Loaded aicore_execute_wrapper from " << aicore_so_path_ << '\n';
+
+        // Optional: AICore binaries without it run on the thread backend only
+        aicore_fiber_func_ = reinterpret_cast<void(*)(Runtime*, int, int, SimFiber*)>(
+            dlsym(aicore_so_handle_, "aicore_execute_fiber"));
     }
 
     return 0;
@@ -158,7 +201,80 @@ int DeviceRunner::run(Runtime& runtime,
                       int device_id,
                       const std::vector<uint8_t>& aicpu_so_binary,
                       const std::vector<uint8_t>& aicore_kernel_binary,
-                      int launch_aicpu_num) {
+                      int launch_aicpu_num,
+                      int mailbox_depth,
+                      int resolve_on_aicore,
+                      int chain_successors,
+                      int sched_policy,
+                      int rebalance_cores,
+                      int sched_group_size) {
+    int rc = launch(runtime, 0, 0, block_dim, device_id, aicpu_so_binary, aicore_kernel_binary, launch_aicpu_num,
+        mailbox_depth, resolve_on_aicore, chain_successors, sched_policy, rebalance_cores, sched_group_size);
+    if (rc != 0) {
+        return rc;
+    }
+    return wait(runtime);
+}
+
+int DeviceRunner::launch(Runtime& runtime,
+                         int partition,
+                         int first_block,
+                         int block_dim,
+                         int device_id,
+                         const std::vector<uint8_t>& aicpu_so_binary,
+                         const std::vector<uint8_t>& aicore_kernel_binary,
+                         int launch_aicpu_num,
+                         int mailbox_depth,
+                         int resolve_on_aicore,
+                         int chain_successors,
+                         int sched_policy,
+                         int rebalance_cores,
+                         int sched_group_size) {
+    if (mailbox_depth < 1 || mailbox_depth > RUNTIME_MAX_MAILBOX_DEPTH) {
+        std::cerr << "Error: mailbox_depth (" << mailbox_depth << ") must be between 1 and "
+                  << RUNTIME_MAX_MAILBOX_DEPTH << '\n';
+        return -1;
+    }
+    if (sched_policy < RUNTIME_SCHED_GRAPH || sched_policy >= RUNTIME_SCHED_POLICY_COUNT) {
+        std::cerr << "Error: unknown sched_policy " << sched_policy << '\n';
+        return -1;
+    }
+    if (sched_group_size < 0) {
+        std::cerr << "Error: sched_group_size (" << sched_group_size << ") must not be negative\n";
+        return -1;
+    }
+    if (partition < 0 || partition >= RUNTIME_MAX_PARTITIONS) {
+        std::cerr << "Error: partition (" << partition << ") must be between 0 and " << RUNTIME_MAX_PARTITIONS - 1
+                  << '\n';
+        return -1;
+    }
+    if (first_block < 0 || block_dim < 1) {
+        std::cerr << "Error: invalid block range " << first_block << " + " << block_dim << '\n';
+        return -1;
+    }
+    if (in_flight(runtime)) {
+        std::cerr << "Error: Runtime is still in flight; wait for it before launching it again\n";
+        return -1;
+    }
+
+    // Partitions in flight keep their blocks until they are waited for
+    for (int p = 0; p < RUNTIME_MAX_PARTITIONS; p++) {
+        const PartitionLaunch& other = partitions_[p];
+        if (!other.in_flight) {
+            continue;
+        }
+        if (p == partition) {
+            std::cerr << "Error: partition " << partition << " is in flight\n";
+            return -1;
+        }
+        if (first_block < other.first_block + other.block_dim && other.first_block < first_block + block_dim) {
+            std::cerr << "Error: blocks [" << first_block << ", " << first_block + block_dim
+                      << ") overlap partition " << p << " in flight on [" << other.first_block << ", "
+                      << other.first_block + other.block_dim << ")\n";
+            return -1;
+        }
+    }
+
     // Ensure device is initialized
     int rc = ensure_device_initialized(device_id, aicpu_so_binary, aicore_kernel_binary);
     if (rc != 0) {
@@ -170,30 +286,23 @@ int DeviceRunner::run(Runtime& runtime,
     block_dim_ = block_dim;
     int num_cores = block_dim * cores_per_blockdim_;
 
-    if (num_cores > RUNTIME_MAX_WORKER) {
-        std::cerr << "Error: num_cores (" << num_cores << ") exceeds RUNTIME_MAX_WORKER ("
-                  << RUNTIME_MAX_WORKER << ")\n";
-        return -1;
-    }
-
-    // Initialize handshake buffers
-    runtime.worker_count = num_cores;
-    worker_count_ = num_cores;
+    // Size the handshake buffers for this topology; there is no fixed core
+    // or thread limit in simulation
     runtime.block_dim = block_dim;
     runtime.sche_cpu_num = launch_aicpu_num;
-
-    // Calculate number of AIC cores
-    int num_aic = block_dim;
-
-    for (int i = 0; i < num_cores; i++) {
-        runtime.workers[i].aicpu_ready = 0;
-        runtime.workers[i].aicore_done = 0;
-        runtime.workers[i].control = 0;
-        runtime.workers[i].task = 0;
-        runtime.workers[i].task_status = 0;
-        // First 1/3 are AIC (0), remaining 2/3 are AIV (1)
-        runtime.workers[i].core_type = (i < num_aic) ? 0 : 1;
+    runtime.sched_group_size = sched_group_size;
+    runtime.partition = partition;
+    runtime.mailbox_depth = mailbox_depth;
+    runtime.resolve_on_aicore = resolve_on_aicore;
+    runtime.chain_successors = chain_successors;
+    runtime.sched_policy = sched_policy;
+    runtime.rebalance_cores = rebalance_cores;
+    if (runtime.reserve_workers(num_cores) != 0) {
+        return -1;
     }
+    worker_count_ = num_cores;
+    launch_aicpu_num_ = launch_aicpu_num;
+    reset_handshakes(runtime);
 
     // Set function_bin_addr for all tasks
     std::cout << "\n=== Setting function_bin_addr for Tasks (Simulation) ===" << '\n';
@@ -217,36 +326,633 @@ int DeviceRunner::run(Runtime& runtime,
         return -1;
     }
 
-    // Launch AICPU threads
-    std::cout << "=== Launching " << launch_aicpu_num << " AICPU thread(s) ===" << '\n';
-    std::vector<std::thread> aicpu_threads;
-    for (int i = 0; i < launch_aicpu_num; i++) {
-        aicpu_threads.emplace_back([this, &runtime]() {
-            aicpu_execute_func_(&runtime);
-        });
+    // The runtime now belongs to this partition only
+    int previous = find_partition(runtime);
+    if (previous >= 0) {
+        partitions_[previous].runtime = nullptr;
+    }
+    PartitionLaunch& slot = partitions_[partition];
+    slot.runtime = &runtime;
+    slot.first_block = first_block;
+    slot.block_dim = block_dim;
+    return start_threads(slot, runtime);
+}
+
+int DeviceRunner::replay(Runtime& runtime) {
+    int rc = launch_replay(runtime);
+    if (rc != 0) {
+        return rc;
+    }
+    return wait(runtime);
+}
+
+int DeviceRunner::launch_replay(Runtime& runtime) {
+    int partition = find_partition(runtime);
+    if (partition < 0 || aicpu_execute_func_ == nullptr || aicore_execute_func_ == nullptr) {
+        std::cerr << "Error: Runtime was not launched; call launch_runtime() before replay\n";
+        return -1;
+    }
+    PartitionLaunch& slot = partitions_[partition];
+    if (slot.in_flight) {
+        std::cerr << "Error: Runtime is still in flight; wait for it before replaying it\n";
+        return -1;
+    }
+    for (int p = 0; p < RUNTIME_MAX_PARTITIONS; p++) {
+        const PartitionLaunch& other = partitions_[p];
+        if (other.in_flight && slot.first_block < other.first_block + other.block_dim &&
+            other.first_block < slot.first_block + slot.block_dim) {
+            std::cerr << "Error: blocks of partition " << partition << " are taken by partition " << p
+                      << " in flight\n";
+            return -1;
+        }
+    }
+
+    // Graph and function_bin_addr are unchanged; the AICPU restores fanin
+    // from the snapshot at init, so only the handshakes need a fresh state.
+    // Rebound parameters were written straight into the task payloads,
+    // which the simulated cores read in place.
+    runtime.clear_param_dirty();
+    reset_handshakes(runtime);
+    last_runtime_ = &runtime;
+    return start_threads(slot, runtime);
+}
+
+int DeviceRunner::wait(Runtime& runtime) {
+    int partition = find_partition(runtime);
+    if (partition < 0 || !partitions_[partition].in_flight) {
+        std::cerr << "Error: Runtime is not in flight\n";
+        return -1;
+    }
+    PartitionLaunch& slot = partitions_[partition];
+    join_threads(slot);
+    if (slot.status != 0) {
+        // A failed launch measured only part of the graph; keep it out of the estimates
+        std::cerr << "Error: AICPU execution failed on partition " << partition << " (" << slot.status << ")\n";
+        return slot.status;
+    }
+
+    // The launch's measurements refine the estimates for the next one
+    runtime.fold_func_samples(cost_model_);
+    return 0;
+}
+
+bool DeviceRunner::in_flight(const Runtime& runtime) const {
+    int partition = find_partition(runtime);
+    return partition >= 0 && partitions_[partition].in_flight;
+}
+
+int DeviceRunner::find_partition(const Runtime& runtime) const {
+    for (int p = 0; p < RUNTIME_MAX_PARTITIONS; p++) {
+        if (partitions_[p].runtime == &runtime) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+void DeviceRunner::attach_runtime(Runtime& runtime) {
+    for (Runtime* live : live_runtimes_) {
+        if (live == &runtime) {
+            return;
+        }
+    }
+    live_runtimes_.push_back(&runtime);
+}
+
+void DeviceRunner::release_runtime(Runtime& runtime) {
+    int partition = find_partition(runtime);
+    if (partition >= 0) {
+        join_threads(partitions_[partition]);
+    }
+    for (size_t i = 0; i < live_runtimes_.size(); i++) {
+        if (live_runtimes_[i] == &runtime) {
+            live_runtimes_.erase(live_runtimes_.begin() + i);
+            break;
+        }
+    }
+    if (live_runtimes_.empty()) {
+        finalize();
+        return;
+    }
+    if (partition >= 0) {
+        partitions_[partition].runtime = nullptr;
+    }
+    if (last_runtime_ == &runtime) {
+        last_runtime_ = nullptr;
+    }
+}
+
+int DeviceRunner::set_idle_wait(int mode, int spin_polls, int yield_polls) {
+    if (mode < RUNTIME_WAIT_SPIN || mode >= RUNTIME_WAIT_MODE_COUNT) {
+        std::cerr << "Error: unknown idle wait mode " << mode << '\n';
+        return -1;
+    }
+    if (spin_polls < 0 || yield_polls < 0) {
+        std::cerr << "Error: idle wait poll counts (" << spin_polls << ", " << yield_polls
+                  << ") must not be negative\n";
+        return -1;
+    }
+    idle_wait_ = mode;
+    idle_spin_ = spin_polls;
+    idle_yield_ = yield_polls;
+    return 0;
+}
+
+int DeviceRunner::set_core_backend(int backend, int host_threads) {
+    if (backend != SIM_CORE_THREADS && backend != SIM_CORE_FIBERS && backend != SIM_CORE_DIRECT) {
+        std::cerr << "Error: unknown core backend " << backend << '\n';
+        return -1;
+    }
+    if (host_threads < 0) {
+        std::cerr << "Error: host thread count " << host_threads << " must not be negative\n";
+        return -1;
+    }
+    core_backend_ = backend;
+    host_threads_ = host_threads;
+    return 0;
+}
+
+void DeviceRunner::reset_handshakes(Runtime& runtime) {
+    // Calculate number of AIC cores
+    int num_aic = runtime.block_dim;
+
+    for (int i = 0; i < runtime.worker_count; i++) {
+        runtime.workers[i].aicpu_ready = 0;
+        runtime.workers[i].aicore_done = 0;
+        runtime.workers[i].control = 0;
+        for (int s = 0; s < RUNTIME_MAX_MAILBOX_DEPTH; s++) {
+            runtime.workers[i].tasks[s] = 0;
+        }
+        runtime.workers[i].post_count = 0;
+        runtime.workers[i].done_count = 0;
+        runtime.workers[i].wake_word = 0;
+        // First 1/3 are AIC (0), remaining 2/3 are AIV (1)
+        runtime.workers[i].core_type = (i < num_aic) ? 0 : 1;
     }
+}
 
-    // Launch AICore threads
-    std::cout << "=== Launching " << num_cores << " AICore thread(s) ===" << '\n';
-    std::vector<std::thread> aicore_threads;
-    for (int i = 0; i < num_cores; i++) {
-        int core_type = runtime.workers[i].core_type;
-        aicore_threads.emplace_back([this, &runtime, i, core_type]() {
-            aicore_execute_func_(&runtime, i, core_type);
+int DeviceRunner::start_threads(PartitionLaunch& slot, Runtime& runtime) {
+    // Priorities follow the latest estimates; wait() folds the launch's
+    // measurements into them
+    if (runtime.apply_cost_model(cost_model_) < 0) {
+        return -1;
+    }
+    runtime.idle_wait = idle_wait_;
+    runtime.idle_spin = idle_spin_;
+    runtime.idle_yield = idle_yield_;
+    runtime.sched_wake = 0;
+    int num_cores = runtime.worker_count;
+    int aicpu_jobs = runtime.sche_cpu_num;
+    int fiber_hosts = 0;
+    int direct_workers = 0;
+    bool gangs = false;
+    int jobs;
+    if (core_backend_ == SIM_CORE_DIRECT) {
+        direct_workers = prepare_direct(slot, runtime, &gangs);
+        if (direct_workers < 0) {
+            return -1;
+        }
+        aicpu_jobs = 0;
+        jobs = gangs ? RUNTIME_MIX_ROLES * direct_workers : direct_workers;
+    } else if (core_backend_ == SIM_CORE_FIBERS) {
+        fiber_hosts = prepare_fibers(slot, runtime);
+        if (fiber_hosts < 0) {
+            return -1;
+        }
+        jobs = aicpu_jobs + fiber_hosts;
+    } else {
+        jobs = aicpu_jobs + num_cores;
+    }
+
+    // Grow the pool to this launch; existing threads are parked on the
+    // doorbell and simply take their job of the new generation
+    size_t spawned = 0;
+    while (slot.threads.size() < static_cast<size_t>(jobs)) {
+        int index = static_cast<int>(slot.threads.size());
+        slot.threads.emplace_back([this, &slot, index]() {
+            pool_thread(slot, index);
         });
+        spawned++;
     }
 
-    // Wait for all threads to complete
-    std::cout << "=== Waiting for threads to complete ===" << '\n';
-    for (auto& t : aicpu_threads) {
-        t.join();
+    if (direct_workers > 0) {
+        std::cout << "=== Launching " << direct_workers << " direct worker(s)" << (gangs ? " with MIX gangs" : "")
+                  << " on partition " << runtime.partition << " (" << spawned << " new pool thread(s)) ===" << '\n';
+    } else {
+        std::cout << "=== Launching " << aicpu_jobs << " AICPU thread(s) on partition " << runtime.partition
+                  << " ===" << '\n';
+        if (fiber_hosts > 0) {
+            std::cout << "=== Launching " << num_cores << " AICore fiber(s) on " << fiber_hosts << " thread(s)";
+        } else {
+            std::cout << "=== Launching " << num_cores << " AICore thread(s)";
+        }
+        std::cout << " on blocks [" << slot.first_block << ", " << slot.first_block + slot.block_dim << ") ("
+                  << spawned << " new pool thread(s)) ===" << '\n';
     }
-    for (auto& t : aicore_threads) {
-        t.join();
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.aicpu_jobs = aicpu_jobs;
+        slot.fiber_hosts = fiber_hosts;
+        slot.direct_workers = direct_workers;
+        slot.jobs = jobs;
+        slot.pending = jobs;
+        slot.status = 0;
+        slot.generation++;
+    }
+    slot.doorbell.notify_all();
+    slot.in_flight = true;
+    return 0;
+}
+
+void DeviceRunner::pool_thread(PartitionLaunch& slot, int index) {
+    uint64_t seen = 0;
+    while (true) {
+        Runtime* runtime;
+        int aicpu_jobs;
+        int fiber_hosts;
+        int direct_workers;
+        {
+            std::unique_lock<std::mutex> lock(slot.mutex);
+            slot.doorbell.wait(lock, [&slot, seen]() { return slot.stop || slot.generation != seen; });
+            if (slot.stop) {
+                return;
+            }
+            seen = slot.generation;
+            if (index >= slot.jobs) {
+                continue;  // Not needed by this launch
+            }
+            runtime = slot.runtime;
+            aicpu_jobs = slot.aicpu_jobs;
+            fiber_hosts = slot.fiber_hosts;
+            direct_workers = slot.direct_workers;
+        }
+
+        int rc = 0;
+        if (direct_workers > 0) {
+            run_direct(slot, index);
+        } else if (index < aicpu_jobs) {
+            rc = aicpu_execute_func_(runtime);
+        } else if (fiber_hosts > 0) {
+            run_fibers(slot, index - aicpu_jobs);
+        } else {
+            int core = index - aicpu_jobs;
+            aicore_execute_func_(runtime, core, runtime->workers[core].core_type);
+        }
+
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (rc != 0 && slot.status == 0) {
+            slot.status = rc;
+        }
+        if (--slot.pending == 0) {
+            slot.finished.notify_all();
+        }
+    }
+}
+
+int DeviceRunner::prepare_fibers(PartitionLaunch& slot, Runtime& runtime) {
+    if (aicore_fiber_func_ == nullptr) {
+        std::cerr << "Error: AICore binary has no aicore_execute_fiber, cannot use the fiber backend\n";
+        return -1;
+    }
+    int num_cores = runtime.worker_count;
+    int hosts = host_threads_;
+    if (hosts == 0) {
+        hosts = std::max<int>(RUNTIME_MIX_ROLES, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    hosts = std::min(hosts, num_cores);
+
+    // The cores of a MIX gang must sit on different host threads (see
+    // sim_fiber.h)
+    if (hosts < RUNTIME_MIX_ROLES) {
+        int task_count = runtime.get_task_count();
+        for (int i = 0; i < task_count; i++) {
+            if (runtime.sched_at(i)->core_type == static_cast<int>(CoreType::MIX)) {
+                std::cerr << "Error: MIX tasks need at least " << RUNTIME_MIX_ROLES
+                          << " fiber host threads, have " << hosts << '\n';
+                return -1;
+            }
+        }
+    }
+
+    // Stacks are kept across launches; contexts are rebuilt every launch
+    slot.fibers.resize(num_cores);
+    while (slot.fiber_stacks.size() < static_cast<size_t>(num_cores)) {
+        slot.fiber_stacks.emplace_back(new char[SIM_FIBER_STACK_SIZE]);
+    }
+    slot.fiber_host_contexts.resize(hosts);
+    slot.gang.task.store(-1, std::memory_order_relaxed);
+    slot.gang.left.store(0, std::memory_order_relaxed);
+
+    int num_aic = runtime.block_dim;
+    for (int core = 0; core < num_cores; core++) {
+        // Core roles of a block land on consecutive host threads
+        int block = core < num_aic ? core : (core - num_aic) / 2;
+        int role = core < num_aic ? 0 : 1 + (core - num_aic) % 2;
+        SimFiber& fiber = slot.fibers[core];
+        fiber.host = &slot.fiber_host_contexts[(RUNTIME_MIX_ROLES * block + role) % hosts];
+        fiber.gang = &slot.gang;
+        fiber.idle = false;
+        fiber.wait_word = nullptr;
+        fiber.wait_armed = 0;
+        fiber.done = false;
+        fiber.runtime = &runtime;
+        fiber.core = core;
+        fiber.core_type = runtime.workers[core].core_type;
+        getcontext(&fiber.context);
+        fiber.context.uc_stack.ss_sp = slot.fiber_stacks[core].get();
+        fiber.context.uc_stack.ss_size = SIM_FIBER_STACK_SIZE;
+        fiber.context.uc_link = fiber.host;
+        makecontext(&fiber.context, &DeviceRunner::fiber_main, 0);
+    }
+    return hosts;
+}
+
+void DeviceRunner::fiber_main() {
+    SimFiber* fiber = t_starting_fiber;
+    get().aicore_fiber_func_(static_cast<Runtime*>(fiber->runtime), fiber->core, fiber->core_type, fiber);
+    fiber->done = true;
+    // Returning resumes uc_link, the host thread's scheduler
+}
+
+void DeviceRunner::run_fibers(PartitionLaunch& slot, int host) {
+    ucontext_t* context = &slot.fiber_host_contexts[host];
+    std::vector<SimFiber*> fibers;
+    for (SimFiber& fiber : slot.fibers) {
+        if (fiber.host == context) {
+            fibers.push_back(&fiber);
+        }
+    }
+
+    // Resume the live fibers round-robin. A pass in which every fiber only
+    // polled gives the CPU up like an idle core thread would, and one in
+    // which every fiber blocked sleeps until any of their words is woken.
+    // A blocked fiber stays parked until its word changes (or the sleep
+    // times out): every switch costs a signal mask syscall in glibc
+    bool timed_out = false;
+    std::vector<volatile uint32_t*> words;
+    std::vector<uint32_t> armed;
+    words.reserve(fibers.size());
+    armed.reserve(fibers.size());
+    size_t live = fibers.size();
+    while (live > 0) {
+        bool idle = true;
+        words.clear();
+        armed.clear();
+        for (SimFiber* fiber : fibers) {
+            if (fiber->done) {
+                continue;
+            }
+            if (fiber->wait_word != nullptr && !timed_out && *fiber->wait_word == fiber->wait_armed) {
+                words.push_back(fiber->wait_word);
+                armed.push_back(fiber->wait_armed);
+                continue;
+            }
+            t_starting_fiber = fiber;
+            swapcontext(context, &fiber->context);
+            if (fiber->done) {
+                live--;
+                idle = false;
+            } else if (!fiber->idle) {
+                idle = false;
+            } else if (fiber->wait_word != nullptr) {
+                words.push_back(fiber->wait_word);
+                armed.push_back(fiber->wait_armed);
+            }
+        }
+        timed_out = false;
+        if (!idle) {
+            continue;
+        }
+        if (!words.empty() && words.size() == live) {
+            timed_out = sim_wait_block_any(words.data(), armed.data(), static_cast<int>(words.size()));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int DeviceRunner::prepare_direct(PartitionLaunch& slot, Runtime& runtime, bool* gangs) {
+    int workers = host_threads_;
+    if (workers == 0) {
+        workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
     }
 
+    // Undo the fanin decrements of any previous launch, as the AICPU does
+    runtime.reset_fanin();
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        runtime.func_samples[f] = FuncSamples{};
+    }
+    int task_count = runtime.get_task_count();
+    std::vector<int> ready(task_count);
+    int ready_count = runtime.get_initial_ready_tasks(ready.data());
+    if (task_count > 0 && ready_count == 0) {
+        std::cerr << "Error: no task of the graph is ready to run\n";
+        return -1;
+    }
+    *gangs = false;
+    for (int i = 0; i < task_count && !*gangs; i++) {
+        *gangs = runtime.sched_at(i)->core_type == static_cast<int>(CoreType::MIX);
+    }
+
+    if (slot.direct_capacity < workers) {
+        slot.direct.reset(new DirectWorker[workers]);
+        slot.direct_capacity = workers;
+    }
+    for (int w = 0; w < workers; w++) {
+        DirectWorker& worker = slot.direct[w];
+        worker.ready.clear();
+        for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+            worker.samples[f] = FuncSamples{};
+        }
+        worker.gang_task = nullptr;
+        worker.gang_quit = false;
+        worker.gang_posted.store(0, std::memory_order_relaxed);
+        worker.gang_finished.store(0, std::memory_order_relaxed);
+        worker.gang_wake = 0;
+        worker.gang_done_wake = 0;
+    }
+    slot.direct_wake = 0;
+
+    // Deal the initially ready tasks round-robin
+    for (int i = 0; i < ready_count; i++) {
+        slot.direct[i % workers].ready.push_back(ready[i]);
+    }
+    slot.direct_left.store(task_count, std::memory_order_relaxed);
+    return workers;
+}
+
+void DeviceRunner::run_direct(PartitionLaunch& slot, int index) {
+    int workers = slot.direct_workers;
+    if (index >= workers) {
+        run_gang_helper(*slot.runtime, slot.direct[(index - workers) / 2], 1 + (index - workers) % 2);
+        return;
+    }
+
+    DirectWorker& self = slot.direct[index];
+    Runtime& runtime = *slot.runtime;
+    int rounds = 0;
+    uint32_t armed = 0;
+    while (slot.direct_left.load(std::memory_order_acquire) > 0) {
+        int task_id = -1;
+        {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            if (!self.ready.empty()) {
+                task_id = self.ready.back();
+                self.ready.pop_back();
+            }
+        }
+        if (task_id < 0) {
+            task_id = steal_direct(slot, index);
+        }
+        if (task_id < 0) {
+            direct_idle_wait(runtime, &slot.direct_wake, ++rounds, &armed);
+            continue;
+        }
+        rounds = 0;
+        armed = 0;
+        run_direct_task(slot, self, runtime, task_id);
+    }
+
+    // Release the gang helpers, then add this worker's measurements to the
+    // launch's for wait()
+    self.gang_quit = true;
+    self.gang_posted.fetch_add(1, std::memory_order_release);
+    sim_wake(&self.gang_wake);
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        runtime.func_samples[f].count += self.samples[f].count;
+        runtime.func_samples[f].sum += self.samples[f].sum;
+        runtime.func_samples[f].sum_sq += self.samples[f].sum_sq;
+    }
+}
+
+void DeviceRunner::run_direct_task(PartitionLaunch& slot, DirectWorker& self, Runtime& runtime, int task_id) {
+    Task* task = runtime.task_at(task_id);
+    TaskSched* sched = runtime.sched_at(task_id);
+    uint64_t start_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (sched->core_type == static_cast<int>(CoreType::MIX)) {
+        // AIC role here, AIV roles on the helpers
+        self.gang_task = task;
+        self.gang_finished.store(0, std::memory_order_relaxed);
+        self.gang_posted.fetch_add(1, std::memory_order_release);
+        sim_wake(&self.gang_wake);
+        if (task->function_bin_addr != 0) {
+            MixKernelFunc kernel = reinterpret_cast<MixKernelFunc>(task->function_bin_addr);
+            kernel(reinterpret_cast<int64_t*>(task->args), 0, reinterpret_cast<uint32_t*>(&self.gang_arrived));
+        }
+        int rounds = 0;
+        uint32_t armed = 0;
+        while (self.gang_finished.load(std::memory_order_acquire) < RUNTIME_MIX_ROLES - 1) {
+            direct_idle_wait(runtime, &self.gang_done_wake, ++rounds, &armed);
+        }
+    } else if (task->function_bin_addr != 0) {
+        UnifiedKernelFunc kernel = reinterpret_cast<UnifiedKernelFunc>(task->function_bin_addr);
+        kernel(reinterpret_cast<int64_t*>(task->args));
+    }
+    uint64_t end_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    task->start_time = start_time;
+    task->end_time = end_time;
+    if (task->func_id >= 0 && task->func_id < RUNTIME_MAX_FUNC_ID) {
+        FuncSamples& samples = self.samples[task->func_id];
+        double duration = static_cast<double>(end_time - start_time);
+        samples.count++;
+        samples.sum += duration;
+        samples.sum_sq += duration * duration;
+    }
+
+    // Successors made ready go to this worker's deque before the task is
+    // counted done, so the launch never looks finished with work queued
+    const int* fanout = runtime.get_fanout(sched);
+    size_t queued = 0;
+    for (int j = 0; j < sched->fanout_count; j++) {
+        int dep_id = fanout[j];
+        if (runtime.sched_at(dep_id)->fanin.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            self.ready.push_back(dep_id);
+            queued = self.ready.size();
+        }
+    }
+    // This worker runs one queued task itself; idle workers may steal the
+    // rest and leave once the last task is done
+    int left = slot.direct_left.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    if (queued > 1 || left == 0) {
+        sim_wake(&slot.direct_wake);
+    }
+}
+
+int DeviceRunner::steal_direct(PartitionLaunch& slot, int thief) {
+    int workers = slot.direct_workers;
+    for (int k = 1; k < workers; k++) {
+        DirectWorker& victim = slot.direct[(thief + k) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ready.empty()) {
+            int task_id = victim.ready.front();
+            victim.ready.pop_front();
+            return task_id;
+        }
+    }
+    return -1;
+}
+
+void DeviceRunner::run_gang_helper(const Runtime& runtime, DirectWorker& leader, int role) {
+    uint32_t seen = 0;
+    uint32_t armed = 0;
+    int polls = 0;
+    while (true) {
+        uint32_t posted = leader.gang_posted.load(std::memory_order_acquire);
+        if (posted == seen) {
+            direct_idle_wait(runtime, &leader.gang_wake, ++polls, &armed);
+            continue;
+        }
+        seen = posted;
+        polls = 0;
+        armed = 0;
+        if (leader.gang_quit) {
+            return;
+        }
+        Task* task = leader.gang_task;
+        if (task->function_bin_addr != 0) {
+            MixKernelFunc kernel = reinterpret_cast<MixKernelFunc>(task->function_bin_addr);
+            kernel(reinterpret_cast<int64_t*>(task->args), role, reinterpret_cast<uint32_t*>(&leader.gang_arrived));
+        }
+        leader.gang_finished.fetch_add(1, std::memory_order_release);
+        sim_wake(&leader.gang_done_wake);
+    }
+}
+
+void DeviceRunner::join_threads(PartitionLaunch& slot) {
+    if (!slot.in_flight) {
+        return;
+    }
+
+    // Wait for every job of the launch; the threads park for the next one
+    std::cout << "=== Waiting for threads to complete ===" << '\n';
+    {
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        slot.finished.wait(lock, [&slot]() { return slot.pending == 0; });
+    }
+    slot.in_flight = false;
+
     std::cout << "=== All threads completed ===" << '\n';
-    return 0;
+}
+
+void DeviceRunner::stop_pool(PartitionLaunch& slot) {
+    join_threads(slot);
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.stop = true;
+    }
+    slot.doorbell.notify_all();
+    for (auto& t : slot.threads) {
+        t.join();
+    }
+    slot.threads.clear();
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    slot.stop = false;
+    slot.generation = 0;
+    slot.jobs = 0;
 }
 
 void DeviceRunner::print_handshake_results() {
@@ -260,7 +966,8 @@ void DeviceRunner::print_handshake_results() {
                   << ": aicore_done=" << last_runtime_->workers[i].aicore_done
                   << " aicpu_ready=" << last_runtime_->workers[i].aicpu_ready
                   << " control=" << last_runtime_->workers[i].control
-                  << " task=" << last_runtime_->workers[i].task << std::endl;
+                  << " posted=" << last_runtime_->workers[i].post_count
+                  << " done=" << last_runtime_->workers[i].done_count << std::endl;
     }
 }
 
@@ -270,6 +977,13 @@ int DeviceRunner::finalize() {
         return 0;
     }
 
+    // No thread may outlive the executors and kernels unloaded below
+    for (auto& slot : partitions_) {
+        stop_pool(slot);
+        slot.runtime = nullptr;
+    }
+    live_runtimes_.clear();
+
     // Print handshake results before cleanup
     print_handshake_results();
 
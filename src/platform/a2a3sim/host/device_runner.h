@@ -7,22 +7,36 @@
  *
  * Key differences from real a2a3:
  * - Uses host memory instead of device memory
- * - Uses std::thread instead of CANN kernel launches
+ * - Uses std::thread instead of CANN kernel launches (a pool per core
+ *   partition, kept across launches); AICores run on one thread each or,
+ *   with the fiber backend, as fibers on a few threads. The direct backend
+ *   skips the AICPU and AICores and runs the task graph on the pool itself
  * - Kernel .text binaries are loaded into executable memory (mmap)
  */
 
 #ifndef RUNTIME_DEVICERUNNER_H
 #define RUNTIME_DEVICERUNNER_H
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "function_cache.h"
 #include "kernel_args.h"
 #include "memory_allocator.h"
 #include "runtime.h"
+#include "sim_fiber.h"
+
+// Execution backends of the simulated AICores (DeviceRunner::set_core_backend())
+#define SIM_CORE_THREADS 0  // One OS thread per AICore
+#define SIM_CORE_FIBERS 1   // Fibers on a few host threads (see sim_fiber.h)
+#define SIM_CORE_DIRECT 2   // No handshakes: the task graph runs on host threads
 
 /**
  * Mapped kernel binary in executable memory
@@ -37,6 +51,84 @@ struct MappedKernel {
     uint64_t func_addr{0};       // Function pointer address (same as exec_mem)
 };
 
+/**
+ * One worker of the direct backend
+ *
+ * The worker pops ready tasks from the back of its deque and pushes the
+ * successors they make ready there; idle workers steal from the front of
+ * the others'. MIX tasks run with the AIC role on the worker and the AIV
+ * roles on two helper threads of its gang, so the kernel's gang barrier
+ * has all three roles running.
+ */
+struct alignas(64) DirectWorker {
+    std::mutex mutex;                           // Guards ready
+    std::deque<int> ready;                      // Ready task IDs
+    FuncSamples samples[RUNTIME_MAX_FUNC_ID];   // Measured durations, summed at the end
+
+    // MIX gang: the worker posts a task by bumping gang_posted and waits
+    // for both helpers to report it in gang_finished
+    Task* gang_task{nullptr};
+    bool gang_quit{false};                      // Helpers return at the next post
+    std::atomic<uint32_t> gang_posted{0};
+    std::atomic<int> gang_finished{0};
+    std::atomic<uint32_t> gang_arrived{0};      // Barrier count passed to the kernel
+    volatile uint32_t gang_wake{0};             // Idle helpers sleep on it (sim_wait.h)
+    volatile uint32_t gang_done_wake{0};        // The worker sleeps on it until both helpers finish
+};
+
+/**
+ * One core partition of the simulated device
+ *
+ * A launch occupies blocks [first_block, first_block + block_dim) of the
+ * device and runs on the partition's own AICPU and AICore threads, so
+ * launches on partitions with disjoint blocks are in flight at the same
+ * time.
+ *
+ * The threads persist across launches: each parks on the doorbell until
+ * a launch bumps the generation, runs its job of that launch (pool thread
+ * i is AICPU thread i for i < aicpu_jobs, else AICore i - aicpu_jobs) and
+ * parks again. The pool grows to the largest launch seen and is torn down
+ * by DeviceRunner::finalize(). On the fiber backend pool thread
+ * aicpu_jobs + h is host thread h, running the AICore fibers placed on it.
+ * On the direct backend pool thread w < direct_workers is worker w and the
+ * next 2 * direct_workers threads (only if the graph has MIX tasks) are
+ * the gang helpers of the workers.
+ */
+struct PartitionLaunch {
+    Runtime* runtime{nullptr};         // Runtime last launched here, replay() target
+    int first_block{0};                // First device block
+    int block_dim{0};                  // Blocks of the launch
+    bool in_flight{false};             // Launch started and not yet waited for
+
+    std::vector<std::thread> threads;  // Pool threads
+    std::mutex mutex;                  // Guards the fields below
+    std::condition_variable doorbell;  // Rung when a launch starts or on stop
+    std::condition_variable finished;  // Notified when pending drops to 0
+    uint64_t generation{0};            // Launches started on the pool
+    int aicpu_jobs{0};                 // AICPU threads of the current launch
+    int jobs{0};                       // Pool threads the current launch uses
+    int pending{0};                    // Jobs of the current launch still running
+    int status{0};                     // First non-zero AICPU result of the current launch
+    int fiber_hosts{0};                // Fiber host threads of the launch, 0 = thread backend
+    int direct_workers{0};             // Direct backend workers of the launch, 0 = other backends
+    bool stop{false};                  // Pool threads exit when set
+
+    // Fiber backend: one fiber per AICore with its stack (kept across
+    // launches), the scheduler context of every host thread and the gang lock
+    std::vector<SimFiber> fibers;
+    std::vector<std::unique_ptr<char[]>> fiber_stacks;
+    std::vector<ucontext_t> fiber_host_contexts;
+    SimFiberGang gang;
+
+    // Direct backend: workers (kept across launches), the tasks of the
+    // launch not yet done and the word idle workers sleep on, rung when
+    // tasks are queued for stealing or the last one is done
+    std::unique_ptr<DirectWorker[]> direct;
+    int direct_capacity{0};
+    std::atomic<int> direct_left{0};
+    volatile uint32_t direct_wake{0};
+};
+
 /**
  * Device runner singleton for simulated kernel execution
  *
@@ -97,9 +189,9 @@ public:
      * This method simulates the complete execution:
      * 1. Initializes worker handshake buffers
      * 2. Sets function_bin_addr for all tasks
-     * 3. Launches AICPU threads
-     * 4. Launches AICore threads
-     * 5. Waits for all threads to complete
+     * 3. Rings the partition's pool doorbell (starting pool threads the
+     *    first time), which runs the AICPU and AICore executors
+     * 4. Waits for all jobs of the launch to complete
      *
      * @param runtime              Runtime to execute
      * @param block_dim            Number of blocks (1 block = 1 AIC + 2 AIV)
@@ -107,6 +199,17 @@ public:
      * @param aicpu_so_binary      AICPU binary (ignored in simulation)
      * @param aicore_kernel_binary AICore binary (ignored in simulation)
      * @param launch_aicpu_num     Number of AICPU threads
+     * @param mailbox_depth        Tasks in flight per core (default: 1)
+     * @param resolve_on_aicore    1 to resolve dependencies on the AICore
+     *                             threads (default: 0, on the AICPU)
+     * @param chain_successors     1 to let cores run chain successors
+     *                             without an AICPU round trip (default: 0)
+     * @param sched_policy         AICPU scheduling policy, RUNTIME_SCHED_*
+     *                             (default: the orchestration's choice)
+     * @param rebalance_cores      1 to move idle blocks between AICPU
+     *                             threads by load (default: 0)
+     * @param sched_group_size     AICPU threads per coordinator group
+     *                             (default: 0, one flat group)
      * @return 0 on success
      */
     int run(Runtime& runtime,
@@ -114,7 +217,154 @@ public:
             int device_id,
             const std::vector<uint8_t>& aicpu_so_binary,
             const std::vector<uint8_t>& aicore_kernel_binary,
-            int launch_aicpu_num = 1);
+            int launch_aicpu_num = 1,
+            int mailbox_depth = 1,
+            int resolve_on_aicore = 0,
+            int chain_successors = 0,
+            int sched_policy = RUNTIME_SCHED_GRAPH,
+            int rebalance_cores = 0,
+            int sched_group_size = 0);
+
+    /**
+     * Start a runtime on a core partition without waiting for it
+     *
+     * Does what run() does up to starting the threads, on device blocks
+     * [first_block, first_block + block_dim), and returns. The runtime is
+     * scheduled by the AICPU executor instance of its partition, so other
+     * runtimes can be in flight on other partitions meanwhile; wait()
+     * joins the launch. run() is launch() on partition 0, block 0, then
+     * wait().
+     *
+     * @param runtime      Runtime to execute, not in flight
+     * @param partition    Partition index (0..RUNTIME_MAX_PARTITIONS-1),
+     *                     not in flight
+     * @param first_block  First device block of the partition; the blocks
+     *                     must not overlap a partition in flight
+     * @param block_dim    Number of blocks (1 block = 1 AIC + 2 AIV)
+     * @return 0 if the launch started, -1 on invalid arguments
+     *
+     * The remaining parameters are those of run().
+     */
+    int launch(Runtime& runtime,
+               int partition,
+               int first_block,
+               int block_dim,
+               int device_id,
+               const std::vector<uint8_t>& aicpu_so_binary,
+               const std::vector<uint8_t>& aicore_kernel_binary,
+               int launch_aicpu_num = 1,
+               int mailbox_depth = 1,
+               int resolve_on_aicore = 0,
+               int chain_successors = 0,
+               int sched_policy = RUNTIME_SCHED_GRAPH,
+               int rebalance_cores = 0,
+               int sched_group_size = 0);
+
+    /**
+     * Relaunch a runtime already executed by run() or launch()
+     *
+     * Resets the handshake buffers and runs the AICPU and AICore threads
+     * again on the runtime's partition with the same launch settings
+     * (block_dim, AICPU thread count, mailbox depth, resolution mode,
+     * chaining). Fanin counts are restored by the AICPU from the graph's
+     * fanin snapshot. Host memory is device memory here, so parameters
+     * rebound with Runtime::set_param() need no upload. Like run(),
+     * installs the cost model before the launch and folds the measured
+     * task durations into it afterwards.
+     *
+     * @param runtime  Runtime previously passed to run() or launch()
+     * @return 0 on success, -1 if runtime was never launched or its
+     *         partition is in flight
+     */
+    int replay(Runtime& runtime);
+
+    /**
+     * Start a replay() without waiting for it; wait() joins it
+     *
+     * @param runtime  Runtime previously passed to run() or launch()
+     * @return 0 if the replay started, -1 as for replay()
+     */
+    int launch_replay(Runtime& runtime);
+
+    /**
+     * Wait for the launch or replay of a runtime to finish
+     *
+     * Waits for the pool threads of the runtime's partition to finish the
+     * launch, which frees the partition for another launch, and folds the
+     * measured task durations into the cost model. A launch whose AICPU
+     * execution failed is not folded.
+     *
+     * @param runtime  Runtime started by launch() or launch_replay()
+     * @return 0 on success, -1 if runtime is not in flight, else the first
+     *         non-zero AICPU result of the launch
+     */
+    int wait(Runtime& runtime);
+
+    /**
+     * Whether a launch or replay of runtime has not been waited for yet
+     */
+    bool in_flight(const Runtime& runtime) const;
+
+    /**
+     * Count a runtime built by init_runtime() as live
+     *
+     * Several runtimes share the simulated device (memory, kernels and
+     * executors), so it is torn down only when the last live one is
+     * released.
+     *
+     * @param runtime  Runtime being initialized
+     */
+    void attach_runtime(Runtime& runtime);
+
+    /**
+     * Forget a runtime being finalized
+     *
+     * Joins it if still in flight and drops it from its partition, so a
+     * later replay of the same address fails instead of running a stale
+     * graph. Releasing the last live runtime finalizes the device.
+     *
+     * @param runtime  Runtime being finalized
+     */
+    void release_runtime(Runtime& runtime);
+
+    /**
+     * Set how idle simulated cores and AICPU threads wait (RUNTIME_WAIT_*)
+     *
+     * Applies to launches and replays started afterwards. Simulated cores
+     * usually outnumber host CPUs; polling threads then take CPU time from
+     * the threads running kernels, which yield mode limits and block mode
+     * (futex sleeps, see sim_wait.h) avoids.
+     *
+     * @param mode        RUNTIME_WAIT_SPIN, RUNTIME_WAIT_YIELD or RUNTIME_WAIT_BLOCK
+     * @param spin_polls  Idle polls that only spin before pausing (>= 0)
+     * @param yield_polls Pausing polls before blocking, block mode (>= 0)
+     * @return 0 on success, -1 on invalid arguments
+     */
+    int set_idle_wait(int mode, int spin_polls, int yield_polls);
+
+    /**
+     * Choose how the simulated AICores of later launches execute
+     *
+     * SIM_CORE_THREADS runs every AICore on its own OS thread.
+     * SIM_CORE_FIBERS runs them as fibers on host_threads host threads
+     * (sim_fiber.h), yielding at handshake polls, so topologies much
+     * larger than the host run without oversubscribing it; results are
+     * the same. AICPU threads are OS threads on both. Launches with MIX
+     * tasks need at least RUNTIME_MIX_ROLES host threads (one per core of
+     * a block).
+     * SIM_CORE_DIRECT emulates neither the AICPU nor the AICores: workers
+     * on host_threads host threads run the task graph straight from the
+     * fanin counters, calling the same kernels (see DirectWorker).
+     * Scheduling policies, placement, mailboxes and chaining do not apply;
+     * with one worker the tasks run in a fixed order.
+     *
+     * @param backend       SIM_CORE_*
+     * @param host_threads  Fiber host threads (capped at the AICore count
+     *                      of a launch) or direct workers; 0 = one per host
+     *                      CPU, for fibers at least RUNTIME_MIX_ROLES
+     * @return 0 on success, -1 on invalid arguments
+     */
+    int set_core_backend(int backend, int host_threads);
 
     /**
      * Print handshake results
@@ -122,7 +372,7 @@ public:
     void print_handshake_results();
 
     /**
-     * Cleanup all resources
+     * Cleanup all resources, stopping the pool threads of every partition
      *
      * @return 0 on success
      */
@@ -150,6 +400,18 @@ public:
      */
     uint64_t get_function_bin_addr(int func_id);
 
+    /**
+     * Online cost model: per-func_id task duration estimates, indexed by
+     * func_id (RUNTIME_MAX_FUNC_ID entries). Every launch and replay
+     * installs it into the runtime first (Runtime::apply_cost_model()) and
+     * folds the durations measured by the AICPU into it afterwards. The
+     * table outlives finalize(), so later runtimes in the process start
+     * from it; the C API exports and pre-seeds it.
+     *
+     * @return Pointer to the table
+     */
+    FuncCost* cost_model() { return cost_model_; }
+
 private:
     DeviceRunner() = default;
     ~DeviceRunner();
@@ -159,6 +421,7 @@ private:
     int block_dim_{0};
     int cores_per_blockdim_{3};
     int worker_count_{0};
+    int launch_aicpu_num_{1};
 
     // Memory management
     MemoryAllocator mem_alloc_;
@@ -172,11 +435,30 @@ private:
     // Runtime pointer for print_handshake_results
     Runtime* last_runtime_{nullptr};
 
+    // Core partitions and the runtimes launched on them (see launch())
+    PartitionLaunch partitions_[RUNTIME_MAX_PARTITIONS];
+
+    // Runtimes initialized and not yet released (see attach_runtime())
+    std::vector<Runtime*> live_runtimes_;
+
+    // AICore execution backend of launches (see set_core_backend())
+    int core_backend_{SIM_CORE_THREADS};
+    int host_threads_{0};
+
+    // Idle waiting of launches (see set_idle_wait())
+    int idle_wait_{RUNTIME_WAIT_BLOCK};
+    int idle_spin_{64};
+    int idle_yield_{64};
+
+    // Cost model estimates per func_id (see cost_model())
+    FuncCost cost_model_[RUNTIME_MAX_FUNC_ID]{};
+
     // Dynamically loaded executor libraries and function pointers
     void* aicpu_so_handle_{nullptr};
     void* aicore_so_handle_{nullptr};
     int (*aicpu_execute_func_)(Runtime*){nullptr};
     void (*aicore_execute_func_)(Runtime*, int, int){nullptr};
+    void (*aicore_fiber_func_)(Runtime*, int, int, SimFiber*){nullptr};
     std::string aicpu_so_path_;
     std::string aicore_so_path_;
 
@@ -186,6 +468,20 @@ private:
                                   const std::vector<uint8_t>& aicore_kernel_binary);
     int ensure_binaries_loaded(const std::vector<uint8_t>& aicpu_so_binary,
                                const std::vector<uint8_t>& aicore_kernel_binary);
+    void reset_handshakes(Runtime& runtime);
+    int find_partition(const Runtime& runtime) const;
+    int start_threads(PartitionLaunch& slot, Runtime& runtime);
+    void join_threads(PartitionLaunch& slot);
+    void pool_thread(PartitionLaunch& slot, int index);
+    int prepare_fibers(PartitionLaunch& slot, Runtime& runtime);
+    void run_fibers(PartitionLaunch& slot, int host);
+    static void fiber_main();
+    int prepare_direct(PartitionLaunch& slot, Runtime& runtime, bool* gangs);
+    void run_direct(PartitionLaunch& slot, int index);
+    void run_direct_task(PartitionLaunch& slot, DirectWorker& self, Runtime& runtime, int task_id);
+    int steal_direct(PartitionLaunch& slot, int thief);
+    void run_gang_helper(const Runtime& runtime, DirectWorker& leader, int role);
+    void stop_pool(PartitionLaunch& slot);
 };
 
 #endif  // RUNTIME_DEVICERUNNER_H
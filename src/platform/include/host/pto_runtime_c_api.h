@@ -122,6 +122,29 @@ int copy_from_device(void* host_ptr, const void* dev_ptr, size_t size);
  * @param aicpu_size       Size of AICPU binary in bytes
  * @param aicore_binary    AICore kernel binary data
  * @param aicore_size      Size of AICore binary in bytes
+ * @param mailbox_depth    Tasks in flight per core (1 to
+ *                         RUNTIME_MAX_MAILBOX_DEPTH). With more than 1 the
+ *                         AICPU stages the next task while the current one
+ *                         runs, hiding the dispatch round trip.
+ * @param resolve_on_aicore 0 to resolve dependencies on the AICPU; 1 to
+ *                         let each AICore decrement its successors' fanin
+ *                         and publish the ready ones to a shared queue in
+ *                         GM, leaving the AICPU only placement and dispatch
+ * @param chain_successors 1 to let a core that finishes a task run its chain
+ *                         successor (same core type, no other predecessor)
+ *                         immediately; the AICPU accounts for it afterwards
+ * @param sched_policy     AICPU scheduling policy (RUNTIME_SCHED_* in
+ *                         runtime.h): -1 keeps the order and placement the
+ *                         orchestration chose; 0 FIFO, 1 LIFO, 2 critical
+ *                         path, 3 shortest job first, 4 locality first
+ * @param rebalance_cores  1 to let AICPU threads move idle blocks from the
+ *                         thread whose cores complete tasks slowest per
+ *                         block to the fastest one while running; 0
+ *                         keeps the initial partition (block_dim need not
+ *                         be a multiple of aicpu_thread_num either way)
+ * @param sched_group_size AICPU threads per coordinator group (hierarchical
+ *                         scheduling, see Runtime::sched_group_size); 0 or
+ *                         1 = one flat group
  * @return 0 on success, error code on failure
  */
 int launch_runtime(RuntimeHandle runtime,
@@ -131,12 +154,190 @@ int launch_runtime(RuntimeHandle runtime,
     const uint8_t* aicpu_binary,
     size_t aicpu_size,
     const uint8_t* aicore_binary,
-    size_t aicore_size);
+    size_t aicore_size,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size);
+
+/**
+ * Start a runtime on a core partition of the device without waiting for it.
+ *
+ * Several runtimes can be in flight at once on disjoint blocks of one
+ * device: the runtime occupies blocks [first_block, first_block +
+ * block_dim) and is scheduled by the AICPU executor instance of its
+ * partition. wait_runtime() waits for it; until then neither the
+ * partition nor its blocks can be used by another launch. launch_runtime()
+ * is this on partition 0 from block 0, followed by wait_runtime().
+ *
+ * On a2a3 the device keeps one graph resident and launches complete
+ * before this returns; on a2a3sim they run concurrently.
+ *
+ * @param runtime      Initialized runtime handle, not in flight
+ * @param partition    Partition, 0 to RUNTIME_MAX_PARTITIONS - 1, not in
+ *                     flight
+ * @param first_block  First block of the partition; the blocks must not
+ *                     overlap those of a partition in flight (and on a2a3
+ *                     must exist on the device)
+ * @return 0 if the launch started, error code on failure
+ *
+ * The remaining parameters are those of launch_runtime().
+ */
+int launch_runtime_async(RuntimeHandle runtime,
+    int partition,
+    int first_block,
+    int aicpu_thread_num,
+    int block_dim,
+    int device_id,
+    const uint8_t* aicpu_binary,
+    size_t aicpu_size,
+    const uint8_t* aicore_binary,
+    size_t aicore_size,
+    int mailbox_depth,
+    int resolve_on_aicore,
+    int chain_successors,
+    int sched_policy,
+    int rebalance_cores,
+    int sched_group_size);
+
+/**
+ * Replay a runtime that was already executed with launch_runtime().
+ *
+ * Runs the same task graph again without re-running orchestration or
+ * rebuilding the Runtime, using the launch settings of the last launch
+ * (block_dim, AICPU thread count, mailbox depth, resolution mode,
+ * chaining, scheduling policy, rebalancing, grouping). Fanin counts are
+ * restored from the snapshot captured when the graph was built. On a2a3 the
+ * device copy of the graph stays resident and only the handshake buffers are
+ * reset.
+ *
+ * Device tensors are reused as-is; results are copied back by
+ * finalize_runtime().
+ *
+ * @param runtime  Runtime handle previously passed to launch_runtime()
+ * @return 0 on success, error code on failure (e.g. runtime never launched)
+ */
+int replay_runtime(RuntimeHandle runtime);
+
+/**
+ * Start a replay_runtime() without waiting for it.
+ *
+ * Runs on the partition the runtime was last launched on; wait_runtime()
+ * waits for it.
+ *
+ * @param runtime  Runtime handle previously launched, not in flight
+ * @return 0 if the replay started, error code on failure
+ */
+int replay_runtime_async(RuntimeHandle runtime);
+
+/**
+ * Wait for a launch_runtime_async() or replay_runtime_async() to finish.
+ *
+ * @param runtime  Runtime handle in flight
+ * @return 0 on success, error code on failure (e.g. runtime not in flight)
+ */
+int wait_runtime(RuntimeHandle runtime);
+
+/**
+ * Rebind a named graph parameter before a replay.
+ *
+ * Writes value (typically a device pointer) into every task argument the
+ * orchestration bound to name with Runtime::bind_param(). On a2a3 only
+ * those argument words are uploaded, at the next replay_runtime(); the
+ * rest of the resident graph is untouched. Buffers bound this way are
+ * owned by the caller and are not copied back by finalize_runtime().
+ *
+ * The simulated or device cores read the arguments while the runtime runs,
+ * so a runtime in flight (launch_runtime_async(), replay_runtime_async())
+ * must be waited for with wait_runtime() first.
+ *
+ * @param runtime  Initialized runtime handle, not in flight
+ * @param name     Parameter name, e.g. "input_a"
+ * @param value    New argument value
+ * @return 0 on success, -1 if the runtime is invalid or in flight, or name
+ *         is unknown
+ */
+int set_runtime_param(RuntimeHandle runtime, const char* name, uint64_t value);
+
+/**
+ * Export the online cost model.
+ *
+ * Every launch and replay measures the execution time of each task and
+ * folds it, per func_id, into a moving average and variance kept across
+ * launches and runtimes (see Runtime::fold_func_samples()). Ranks, and so
+ * the critical-path and shortest-job priorities, use these estimates for
+ * kernels without an explicit Runtime::set_func_cost(). Times are in
+ * device timer ticks (nanoseconds on a2a3sim).
+ *
+ * Copies the first min(capacity, table size) entries, indexed by func_id;
+ * any output pointer may be NULL to skip that column.
+ *
+ * @param samples   Receives tasks measured per func_id (0 = no estimate)
+ * @param mean      Receives the mean duration per func_id
+ * @param var       Receives the duration variance per func_id
+ * @param capacity  Entries available in each non-NULL array
+ * @return Number of entries in the table (RUNTIME_MAX_FUNC_ID), -1 on error
+ */
+int get_cost_model(uint64_t* samples, double* mean, double* var, int capacity);
+
+/**
+ * Pre-seed the online cost model, e.g. with a table exported by a previous
+ * run. Replaces the whole table: func_ids from count on have no estimate.
+ * Takes effect for runtimes initialized and launches started afterwards.
+ *
+ * @param samples  Tasks measured per func_id (0 = no estimate)
+ * @param mean     Mean duration per func_id (>= 0)
+ * @param var      Duration variance per func_id (>= 0)
+ * @param count    Entries in each array (at most the table size)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int set_cost_model(const uint64_t* samples, const double* mean, const double* var, int count);
+
+/**
+ * Choose how idle AICores and AICPU threads wait for each other.
+ *
+ * Every mode polls spin_polls times first. RUNTIME_WAIT_YIELD (1) then
+ * yields the host CPU between polls; RUNTIME_WAIT_BLOCK (2) yields for
+ * yield_polls more polls and then sleeps on a futex until the other side
+ * writes the handshake; RUNTIME_WAIT_SPIN (0) keeps polling. Only a2a3sim
+ * distinguishes the modes, where simulated cores usually outnumber host
+ * CPUs (default: block, 64 spinning and 64 yielding polls); hardware cores
+ * and AICPU threads always poll. Applies to launches and replays started
+ * afterwards.
+ *
+ * @param mode         RUNTIME_WAIT_* idle wait mode
+ * @param spin_polls   Idle polls that only spin (>= 0)
+ * @param yield_polls  Yielding polls before sleeping, block mode (>= 0)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int set_idle_wait(int mode, int spin_polls, int yield_polls);
+
+/**
+ * Choose how simulated AICores execute.
+ *
+ * Backend 0 runs every AICore on its own host thread; backend 1 runs them
+ * as user-space fibers on host_threads host threads (0 = one per host CPU,
+ * at least 3), switching at handshake polls, so large topologies do not
+ * oversubscribe the host. Backend 2 emulates no handshakes: host_threads
+ * work-stealing workers (0 = one per host CPU) run the task graph from its
+ * fanin counters and call the kernels directly; one worker runs the tasks
+ * in a fixed order. All give the same results. Only a2a3sim has backends
+ * 1 and 2. Applies to launches and replays started afterwards.
+ *
+ * @param backend       0 = threads, 1 = fibers, 2 = direct
+ * @param host_threads  Fiber host threads (>= 0, capped at the AICore count)
+ *                      or direct workers
+ * @return 0 on success, -1 on invalid arguments or unsupported backend
+ */
+int set_core_backend(int backend, int host_threads);
 
 /**
  * Finalize and cleanup a runtime instance.
  *
- * Validates results, frees device tensors, calls Runtime destructor.
+ * Waits for the runtime if it is still in flight, validates results, frees
+ * device tensors, calls Runtime destructor.
  * After this call, user can free(runtime).
  *
  * @param runtime  Runtime handle to finalize
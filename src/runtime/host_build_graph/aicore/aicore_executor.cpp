@@ -9,6 +9,12 @@
  */
 typedef void (*UnifiedKernelFunc)(__gm__ int64_t*);
 
+/**
+ * MIX kernel signature (see CoreType::MIX): the core's role in the gang
+ * and the block's barrier arrival count come after the arguments
+ */
+typedef void (*MixKernelFunc)(__gm__ int64_t*, int, __gm__ uint32_t*);
+
 /**
  * Task execution wrapper - dispatches tasks using function pointers
  *
@@ -46,19 +52,126 @@ __aicore__ __attribute__((always_inline)) static void execute_task(__gm__ Task*
     kernel(reinterpret_cast<__gm__ int64_t*>(task->args));
 }
 
+/**
+ * Gang barrier of a MIX task: add an arrival to the block's count and wait
+ * for the other cores of the gang. The count only grows, so barriers in a
+ * row need no reset.
+ *
+ * @param arrived  mix_arrived of the block's AIC handshake
+ */
+__aicore__ static inline __attribute__((always_inline)) void mix_barrier(__gm__ std::atomic<uint32_t>* arrived) {
+    uint32_t ticket = arrived->fetch_add(1, std::memory_order_acq_rel);
+    uint32_t target = ticket - ticket % RUNTIME_MIX_ROLES + RUNTIME_MIX_ROLES;
+    while (static_cast<int32_t>(arrived->load(std::memory_order_acquire) - target) < 0) {
+        aicore_spin_pause();
+    }
+}
+
+/**
+ * Run this core's share of a MIX task, then wait at the gang barrier so
+ * that no core of the block reports the task done before all three are.
+ * On the simulator's fiber backend the gang holds the launch's gang lock
+ * meanwhile.
+ *
+ * @param runtime  Runtime in global memory
+ * @param task     MIX task posted to every core of the block
+ * @param hank     This core's handshake (mix_role, mix_leader)
+ */
+__aicore__ static inline __attribute__((always_inline)) void execute_mix_task(
+    __gm__ Runtime* runtime, __gm__ Task* task, __gm__ Handshake* hank) {
+    __gm__ std::atomic<uint32_t>* arrived = &runtime->workers[hank->mix_leader].mix_arrived;
+    aicore_gang_begin(task->task_id);
+    if (task->function_bin_addr != 0) {
+        MixKernelFunc kernel = (MixKernelFunc)task->function_bin_addr;
+        kernel(reinterpret_cast<__gm__ int64_t*>(task->args), hank->mix_role,
+            reinterpret_cast<__gm__ uint32_t*>(arrived));
+    }
+    mix_barrier(arrived);
+    aicore_gang_end(RUNTIME_MIX_ROLES);
+}
+
+/**
+ * Decentralized dependency resolution (Runtime::resolve_on_aicore)
+ *
+ * Decrements the fanin of every successor of a task that just finished on
+ * this core and publishes the ones that became ready to the resolved queue
+ * in GM, where an AICPU thread picks them up for placement. Runs before the
+ * completion is reported, so a task is never counted done while its
+ * successors are still unpublished.
+ *
+ * @param runtime   Runtime in global memory
+ * @param task_id   Task that just finished
+ * @param chain_id  Successor this core runs next itself (not published),
+ *                  -1 if none
+ */
+__aicore__ static inline __attribute__((always_inline)) void resolve_successors(
+    __gm__ Runtime* runtime, int task_id, int chain_id) {
+    __gm__ TaskSched* sched = runtime->sched_at(task_id);
+    const __gm__ int* fanout = runtime->get_fanout(sched);
+    for (int j = 0; j < sched->fanout_count; j++) {
+        int dep_id = fanout[j];
+        if (runtime->sched_at(dep_id)->fanin.fetch_sub(1, std::memory_order_acq_rel) == 1 && dep_id != chain_id) {
+            runtime->publish_resolved(dep_id);
+        }
+    }
+}
+
+/**
+ * One idle poll of a core waiting for the AICPU to write its handshake
+ *
+ * Follows the runtime's idle waiting mode (RUNTIME_WAIT_*): the first
+ * idle_spin polls only spin, later ones pause, and in block mode every
+ * poll past idle_spin + idle_yield either arms the handshake's wake word
+ * or, when the poll after arming still found nothing, sleeps on it.
+ *
+ * @param runtime  Runtime in global memory
+ * @param hank     The core's handshake
+ * @param polls    Consecutive idle polls, this one included
+ * @param armed    Token of the armed wake word, 0 if not armed
+ */
+__aicore__ static inline __attribute__((always_inline)) void idle_poll(
+    __gm__ Runtime* runtime, __gm__ Handshake* hank, uint32_t polls, uint32_t* armed) {
+    int mode = runtime->idle_wait;
+    uint32_t spin = static_cast<uint32_t>(runtime->idle_spin);
+    if (mode == RUNTIME_WAIT_SPIN || polls <= spin) {
+        // Spinning polls still switch fibers on the simulator's fiber backend
+        aicore_fiber_poll(polls > 1);
+        return;
+    }
+    if (mode == RUNTIME_WAIT_YIELD || polls <= spin + static_cast<uint32_t>(runtime->idle_yield)) {
+        aicore_spin_pause();
+        return;
+    }
+    if (*armed == 0) {
+        *armed = aicore_wait_arm(&hank->wake_word);
+        return;
+    }
+    aicore_wait_block(&hank->wake_word, *armed);
+    *armed = 0;
+}
+
 __aicore__ __attribute__((weak)) void aicore_execute(__gm__ Runtime* runtime, int block_idx, int core_type) {
     (void)core_type;
     __gm__ Handshake* my_hank = (__gm__ Handshake*)(&runtime->workers[block_idx]);
 
     // Phase 1: Wait for AICPU initialization signal
+    uint32_t idle_polls = 0;
+    uint32_t armed = 0;
     while (my_hank->aicpu_ready == 0) {
+        idle_poll(runtime, my_hank, ++idle_polls, &armed);
         dcci(my_hank, ENTIRE_DATA_CACHE, CACHELINE_OUT);
     }
 
     // Phase 2: Signal AICore is ready (use core_id + 1 to avoid 0)
     my_hank->aicore_done = block_idx + 1;
+    idle_polls = 0;
+    armed = 0;
 
     // Phase 3: Main execution loop - poll for tasks until quit signal
+    bool resolve_on_aicore = runtime->resolve_on_aicore != 0;
+    bool chain_successors = runtime->chain_successors != 0 && runtime->chain_next != nullptr;
+    uint32_t taken = 0;  // Mailbox slots consumed
+    uint32_t done = 0;   // Tasks executed, chained ones included
     while (true) {
         dcci(my_hank, ENTIRE_DATA_CACHE, CACHELINE_OUT);
 
@@ -67,12 +180,60 @@ __aicore__ __attribute__((weak)) void aicore_execute(__gm__ Runtime* runtime, in
             break;  // Exit kernel
         }
 
-        // Execute task if assigned (task != 0 means valid Task* pointer)
-        if (my_hank->task_status == 1 && my_hank->task != 0) {
-            __gm__ Task* task_ptr = reinterpret_cast<__gm__ Task*>(my_hank->task);
-            execute_task(task_ptr);
-            // Mark task as complete (task_status: 0=idle, 1=busy)
-            my_hank->task_status = 0;
+        // An idle core spins for a while, then pauses between polls and
+        // may sleep (in simulation, where the AICPU it waits on may need the
+        // host CPU)
+        if (taken == my_hank->post_count) {
+            idle_poll(runtime, my_hank, ++idle_polls, &armed);
+            continue;
+        }
+        idle_polls = 0;
+        armed = 0;
+
+        // Drain every task staged in the mailbox without waiting for the
+        // AICPU in between
+        while (taken != my_hank->post_count) {
+            __gm__ Task* task_ptr =
+                reinterpret_cast<__gm__ Task*>(my_hank->tasks[taken % RUNTIME_MAX_MAILBOX_DEPTH]);
+            taken++;
+
+            // Run the task, then its chain successors: each is ready as soon
+            // as its sole predecessor is done, so no AICPU round trip is
+            // needed. The AICPU follows the same chain_next table when it
+            // sees the completions.
+            // A MIX task is posted to the whole block; the AIC (role 0)
+            // times it and resolves its successors for the gang. The
+            // start/end stamps reach the AICPU (cost model) with the
+            // completion below.
+            while (task_ptr != nullptr) {
+                int task_id = task_ptr->task_id;
+                bool mix = runtime->sched_at(task_id)->core_type == static_cast<int>(CoreType::MIX);
+                bool lead = !mix || my_hank->mix_role == 0;
+                uint64_t start_time = aicore_clock();
+                if (mix) {
+                    execute_mix_task(runtime, task_ptr, my_hank);
+                } else {
+                    execute_task(task_ptr);
+                }
+                if (lead) {
+                    task_ptr->start_time = start_time;
+                    task_ptr->end_time = aicore_clock();
+                }
+                int chain_id = chain_successors ? runtime->chain_next[task_id] : -1;
+                if (resolve_on_aicore && lead) {
+                    resolve_successors(runtime, task_id, chain_id);
+                }
+                // Publish completion; the AICPU may now reuse the slot
+                done++;
+                my_hank->done_count = done;
+                dcci(my_hank, ENTIRE_DATA_CACHE, CACHELINE_OUT);
+                // Read the doorbell bit each time: when scheduler threads
+                // rebalance, the core's new owner reassigns it before
+                // posting the core its first task
+                runtime->ring_doorbell(my_hank->doorbell_word, my_hank->doorbell_mask);
+                aicore_wake(&runtime->sched_wake);
+                task_ptr = chain_id >= 0 ? reinterpret_cast<__gm__ Task*>(runtime->task_at(chain_id)) : nullptr;
+            }
         }
     }
 }
@@ -1,14 +1,113 @@
 #include <atomic>
 #include <cstdint>
-#include <mutex>
+#include <memory>
+#include <new>
+#include <vector>
 
+#include "aicpu.h"
 #include "device_log.h"
+#include "ready_queue.h"
 #include "runtime.h"
+#include "sched_policy.h"
 
-constexpr int MAX_AICPU_THREADS = 4;
-constexpr int MAX_AIC_PER_THREAD = 24;
-constexpr int MAX_AIV_PER_THREAD = 48;
-constexpr int MAX_CORES_PER_THREAD = MAX_AIC_PER_THREAD + MAX_AIV_PER_THREAD;
+constexpr int READY_BATCH = 64;  // Successors published per bulk push
+
+// Successors made ready by one completion, published together per level
+struct ReadyBatch {
+    int count;
+    int levels[READY_BATCH];
+    int task_ids[READY_BATCH];
+};
+
+constexpr int PLACEMENT_ANY = 0;       // Any idle core takes the next ready task
+constexpr int PLACEMENT_LOCALITY = 1;  // Prefer the core that produced the input
+constexpr int AFFINITY_SLOTS = 8;      // Tasks held per block and core type
+
+// A ready task held for the block of the core that produced its input
+struct AffinityEntry {
+    int task_id;
+    int core_id;  // Preferred core, -1 if the producer ran on the other core type
+    int since;    // Scheduler round in which the task became ready
+};
+
+struct AffinityBuffer {
+    int count;
+    AffinityEntry entries[AFFINITY_SLOTS];
+};
+
+constexpr int REBALANCE_WINDOW = 256;   // Completions (all threads) per load window
+constexpr int REBALANCE_MIN_LOAD = 16;  // Receiver completions per window to trust its rate
+constexpr int INBOX_EMPTY = -1;
+constexpr int INBOX_CLOSED = -2;
+
+// Tasks completed by one scheduler thread, on its own cache line so the
+// threads never contend on a shared counter. recent holds the completions
+// on the thread's cores during its last window of REBALANCE_WINDOW
+// completions by all threads, and blocks the blocks it owned meanwhile:
+// recent / blocks is the observed completion rate of its cores.
+struct alignas(64) CompletionShard {
+    std::atomic<int> count{0};
+    std::atomic<int> recent{0};
+    std::atomic<int> blocks{0};
+};
+
+// Block handed from one scheduler thread to another (core rebalancing)
+struct alignas(64) BlockInbox {
+    std::atomic<int> block{INBOX_EMPTY};
+};
+
+// Core slots of one scheduler thread. Slot i is bit i of the thread's run
+// of doorbell words and of its free mask; it holds a core ID, or -1 once
+// that core was handed to another thread.
+struct ThreadSlots {
+    int* cores;         // Runtime::thread_slot_capacity() entries
+    int used;           // Slots in use, holes included
+    int doorbell_base;  // First word of the thread's doorbell run
+    int words;          // Words in the run
+};
+
+// What a group coordinator publishes for everyone (hierarchical mode), per
+// core type where there are two entries
+struct alignas(64) GroupState {
+    std::atomic<int> completed{0};  // Tasks completed by the group's threads
+    std::atomic<int> ready[2];      // Tasks in the group's ready queues
+    std::atomic<int> donor[2];      // Group to steal from once the own group is dry, -1 if none
+};
+
+// Ready queue of a core type. MIX tasks wait in the AIC queue: the block's
+// AIC takes them and leads the gang.
+static inline int queue_of(int core_type) {
+    return core_type == static_cast<int>(CoreType::AIV) ? 1 : 0;
+}
+
+// Replace launch-sized storage with count value-initialized elements
+template <typename T>
+static bool allocate(std::unique_ptr<T[]>& storage, int count) {
+    storage.reset(new (std::nothrow) T[count]());
+    return storage != nullptr;
+}
+
+// One idle scheduler round under the runtime's idle waiting mode
+// (RUNTIME_WAIT_*): spin for the first idle_spin rounds, then pause, and in
+// block mode past idle_spin + idle_yield rounds arm sched_wake, sleeping on
+// it in the next round if that one found nothing either. Returns true if
+// a sleep timed out without a wake.
+static bool idle_wait(Runtime& runtime, int rounds, uint32_t* armed) {
+    if (runtime.idle_wait == RUNTIME_WAIT_SPIN || rounds <= runtime.idle_spin) {
+        return false;
+    }
+    if (runtime.idle_wait == RUNTIME_WAIT_YIELD || rounds <= runtime.idle_spin + runtime.idle_yield) {
+        aicpu_spin_pause();
+        return false;
+    }
+    if (*armed == 0) {
+        *armed = aicpu_wait_arm(&runtime.sched_wake);
+        return false;
+    }
+    bool timed_out = aicpu_wait_block(&runtime.sched_wake, *armed);
+    *armed = 0;
+    return timed_out;
+}
 
 struct AicpuExecutor {
     // ===== Thread management state =====
@@ -21,38 +120,672 @@ struct AicpuExecutor {
     int thread_num_{0};
     int cores_total_num_{0};
     int blockdim_cores_num_{3};
-    int thread_cores_num_{0};
-    int core_assignments_[MAX_AICPU_THREADS][MAX_CORES_PER_THREAD];
+    int num_aic_{0};
+
+    // Every array below is sized by init() for the launch's threads, blocks
+    // and cores (reserve_storage()); there is no compile-time topology
+    // limit. Storage only grows, so replays and smaller launches reuse it.
+    int thread_capacity_{0};
+    int block_capacity_{0};
+    int core_capacity_{0};
+    int slot_capacity_{0};
+    int group_capacity_{0};
+
+    // Cores each thread manages. Blocks are dealt as evenly as block_dim
+    // allows (threads may differ by one block, see
+    // Runtime::thread_first_block()); a thread's slots live in
+    // core_slots_ and can hold every core when blocks may move
+    std::unique_ptr<ThreadSlots[]> thread_slots_;
+    std::unique_ptr<int[]> core_slots_;
+    std::unique_ptr<std::atomic<int>[]> block_owner_;
+
+    // Hierarchical scheduling (Runtime::sched_group_size): threads
+    // [g * group_size_, (g + 1) * group_size_) form group g and the first
+    // of them is its coordinator. Threads steal and hand blocks on only
+    // within their group. Every round the coordinator sums its group's
+    // completion shards and ready queues into groups_[g], so termination
+    // checks read one counter per group instead of one per thread, and
+    // names the group with the most ready tasks as the donor its threads
+    // steal from once their own group has none. Flat scheduling is one
+    // group of all threads.
+    int group_size_{1};
+    int group_num_{1};
+    std::unique_ptr<GroupState[]> groups_;
+
+    // With Runtime::rebalance_cores a thread whose cores complete tasks at
+    // under half the rate of another thread's cores (its dispatch cannot
+    // keep them busy) hands one of its idle blocks to that thread through
+    // the thread's inbox. A thread closes its
+    // inbox when it stops scheduling, so a block is never handed to a
+    // thread that will not shut its cores down.
+    bool rebalance_{false};
+    std::unique_ptr<BlockInbox[]> inboxes_;
+
+    // Per-core mailbox state, owned by the thread that manages the core.
+    // core_task_ids_ mirrors the Task* ring in the handshake by task ID so
+    // completion never has to read the (cold) task payload to tell which
+    // task finished (only its timing line, for the cost model); the AICPU keeps
+    // at most mailbox_depth_ tasks posted but not yet completed. With
+    // chaining a core also runs chain successors between slot tasks; the
+    // AICPU tracks which one it expects next in core_chain_.
+    std::unique_ptr<int[][RUNTIME_MAX_MAILBOX_DEPTH]> core_task_ids_;
+    std::unique_ptr<uint32_t[]> core_posted_;     // Tasks posted to the core
+    std::unique_ptr<uint32_t[]> core_completed_;  // Posted tasks completed
+    std::unique_ptr<uint32_t[]> core_executed_;   // Completions processed (incl. chained)
+    std::unique_ptr<int[]> core_chain_;           // Chained task the core runs next, -1 if none
+    int mailbox_depth_{1};
+
+    // MIX task the block's AIC took that waits for a free mailbox slot on
+    // both of the block's AIVs, -1 if none. Until it is posted to all three
+    // cores at once the AIVs take no new tasks, so the gang cannot starve.
+    // Owned by the block's thread, like the affinity buffers.
+    std::unique_ptr<int[]> block_gang_;
+    bool chain_successors_{false};
+    const int* chain_next_{nullptr};
 
     // ===== Task queue state =====
-    std::mutex ready_queue_aic_mutex_;
-    int ready_queue_aic_[RUNTIME_MAX_TASKS];
-    std::atomic<int> ready_count_aic_{0};
-
-    std::mutex ready_queue_aiv_mutex_;
-    int ready_queue_aiv_[RUNTIME_MAX_TASKS];
-    std::atomic<int> ready_count_aiv_{0};
-
-    // Task execution tracking
-    std::atomic<int> completed_tasks_{0};
+    // Each scheduler thread owns one lock-free MPMC queue per core type
+    // ([thread][0] = AIC, [thread][1] = AIV). A thread publishes the
+    // successors it resolves to its own queues so its cores pick them up
+    // first, and steals from a sibling's queue only when its own is empty.
+    // Any thread may ready any task, so every queue is sized in init() to
+    // all tasks of its type. Tasks are placed on a priority level by the
+    // scheduling policy's priority (one level for FIFO).
+    std::unique_ptr<ReadyQueue[][2]> ready_queues_;
+
+    // With Runtime::resolve_on_aicore the AICores resolve successors
+    // themselves; scheduler threads only move the tasks they publish from
+    // the shared resolved queue into their own ready queues
+    bool resolve_on_aicore_{false};
+
+    // Scheduling policy of this launch, one of the instances below
+    SchedPolicy* policy_{nullptr};
+    FifoPolicy fifo_policy_;
+    LifoPolicy lifo_policy_;
+    CriticalPathPolicy critical_path_policy_;
+    ShortestJobPolicy shortest_job_policy_;
+    LocalityPolicy locality_policy_;
+
+    // With locality placement (Runtime::placement_policy, or a policy that
+    // prefers locality) a successor made ready by a completion is held in
+    // the producer block's buffer for its core type instead of the ready
+    // queue. An idle core of the block takes held tasks first, its own
+    // before its sibling's; tasks still held after locality_wait_ rounds
+    // move to the thread's ready queue. Each block is owned by one thread,
+    // so the buffers need no synchronization.
+    int placement_policy_{PLACEMENT_ANY};
+    int locality_wait_{0};
+    std::unique_ptr<int[]> core_block_;
+    std::unique_ptr<AffinityBuffer[][2]> affinity_;
+
+    std::vector<int> initial_ready_;
+
+    // Task execution tracking: each thread publishes its own completion
+    // count; the total is the sum over the shards
+    std::unique_ptr<CompletionShard[]> completed_shards_;
     std::atomic<int> total_tasks_{0};
     std::atomic<int> finished_count_{0};
 
+    // Cost model: durations of the tasks completed on each thread's cores
+    // per func_id, taken from the start/end stamps in the task payload. The
+    // last thread to finish sums them into Runtime::func_samples.
+    std::unique_ptr<FuncSamples[][RUNTIME_MAX_FUNC_ID]> thread_samples_;
+
     // ===== Methods =====
     int init(Runtime* runtime);
+    bool reserve_storage(int slot_count);
     int hank_aicore(Runtime* runtime, int thread_idx, const int* cur_thread_cores);
-    int resolve_and_dispatch(Runtime& runtime, int thread_idx, const int* cur_thread_cores, int core_num);
+    int resolve_and_dispatch(Runtime& runtime, int thread_idx, const int* cur_thread_cores);
     int shutdown_aicore(Runtime* runtime, int thread_idx, const int* cur_thread_cores);
     int run(Runtime* runtime);
     void deinit();
+    int ready_level(int task_id) const;
+    bool publish_ready(ReadyQueue& queue, ReadyBatch& batch);
+    int pop_ready(int thread_idx, int queue_idx, bool allow_steal, bool* stolen);
+    void coordinate_group(int thread_idx);
+    int place_resolved(Runtime& runtime, int thread_idx);
+    int ready_count(int queue_idx) const;
+    int completed_count() const;
+    uint32_t core_occupancy(int core_id) const;
+    void post_task(Handshake* hank, int core_id, int task_id, Task* task);
+    void record_duration(int thread_idx, const Task* task);
+    void publish_samples(Runtime* runtime);
+    bool post_gang(Runtime& runtime, Handshake* hank, int block);
+    bool donate_block(Runtime& runtime, int thread_idx, uint64_t* free_mask);
+    void adopt_block(Runtime& runtime, int thread_idx, int block, uint64_t* free_mask);
+    bool hold_for_block(int producer_core, int queue_idx, int task_id, int round);
+    int take_held(int core_id, int queue_idx, bool* same_core);
+    bool release_held(int thread_idx, int round);
+    int held_count(int thread_idx) const;
     void diagnose_stuck_state(Runtime& runtime, int thread_idx, const int* cur_thread_cores,
                               int core_num, Handshake* hank);
 };
 
-static AicpuExecutor g_aicpu_executor;
+// One executor per core partition: runtimes launched concurrently on
+// disjoint blocks each get their own threads' state (Runtime::partition)
+static AicpuExecutor g_aicpu_executors[RUNTIME_MAX_PARTITIONS];
 
 // ===== AicpuExecutor Method Implementations =====
 
+/**
+ * Priority level of a task: its policy priority scaled onto READY_LEVELS
+ */
+int AicpuExecutor::ready_level(int task_id) const {
+    int64_t level = static_cast<int64_t>(policy_->priority(task_id)) * READY_LEVELS /
+                    (static_cast<int64_t>(policy_->max_priority()) + 1);
+    if (level < 0) {
+        return 0;
+    }
+    return level >= READY_LEVELS ? READY_LEVELS - 1 : static_cast<int>(level);
+}
+
+/**
+ * Publish a batch of ready tasks with one bulk push per level and empty it
+ */
+bool AicpuExecutor::publish_ready(ReadyQueue& queue, ReadyBatch& batch) {
+    // Insertion sort by level so each level's tasks are contiguous
+    for (int i = 1; i < batch.count; i++) {
+        int level = batch.levels[i];
+        int task_id = batch.task_ids[i];
+        int j = i;
+        while (j > 0 && batch.levels[j - 1] > level) {
+            batch.levels[j] = batch.levels[j - 1];
+            batch.task_ids[j] = batch.task_ids[j - 1];
+            j--;
+        }
+        batch.levels[j] = level;
+        batch.task_ids[j] = task_id;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < batch.count;) {
+        int j = i + 1;
+        while (j < batch.count && batch.levels[j] == batch.levels[i]) {
+            j++;
+        }
+        if (!queue.push_bulk(batch.levels[i], &batch.task_ids[i], j - i)) {
+            DEV_ERROR("Ready queue level %d overflow (task %d pushed twice?)", batch.levels[i], batch.task_ids[i]);
+            ok = false;
+        }
+        i = j;
+    }
+    batch.count = 0;
+    return ok;
+}
+
+/**
+ * Pop a ready task for a core of this thread: own queue first, then (if
+ * allowed) the queues of the siblings in its group starting from the next
+ * thread, then those of the donor group its coordinator named
+ */
+int AicpuExecutor::pop_ready(int thread_idx, int queue_idx, bool allow_steal, bool* stolen) {
+    int task_id = ready_queues_[thread_idx][queue_idx].pop();
+    *stolen = false;
+    if (task_id >= 0 || !allow_steal) {
+        return task_id;
+    }
+    int group = thread_idx / group_size_;
+    int first = group * group_size_;
+    int members = thread_num_ - first < group_size_ ? thread_num_ - first : group_size_;
+    for (int k = 1; k < members; k++) {
+        int victim = first + (thread_idx - first + k) % members;
+        task_id = ready_queues_[victim][queue_idx].pop();
+        if (task_id >= 0) {
+            *stolen = true;
+            return task_id;
+        }
+    }
+    int donor = group_num_ > 1 ? groups_[group].donor[queue_idx].load(std::memory_order_relaxed) : -1;
+    if (donor < 0) {
+        return -1;
+    }
+    int donor_end = (donor + 1) * group_size_ < thread_num_ ? (donor + 1) * group_size_ : thread_num_;
+    for (int victim = donor * group_size_; victim < donor_end; victim++) {
+        task_id = ready_queues_[victim][queue_idx].pop();
+        if (task_id >= 0) {
+            *stolen = true;
+            return task_id;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Coordinator round (hierarchical mode): publish the group's completions
+ * and ready tasks, and for each core type the group has no ready task of,
+ * name the group with the most as its donor
+ */
+void AicpuExecutor::coordinate_group(int thread_idx) {
+    int group = thread_idx / group_size_;
+    int end = (group + 1) * group_size_ < thread_num_ ? (group + 1) * group_size_ : thread_num_;
+    int completed = 0;
+    int ready[2] = {0, 0};
+    for (int t = group * group_size_; t < end; t++) {
+        completed += completed_shards_[t].count.load(std::memory_order_acquire);
+        ready[0] += ready_queues_[t][0].size();
+        ready[1] += ready_queues_[t][1].size();
+    }
+    GroupState& state = groups_[group];
+    state.completed.store(completed, std::memory_order_release);
+    for (int q = 0; q < 2; q++) {
+        state.ready[q].store(ready[q], std::memory_order_relaxed);
+        int donor = -1;
+        int most = 0;
+        for (int g = 0; g < group_num_ && ready[q] == 0; g++) {
+            int other = groups_[g].ready[q].load(std::memory_order_relaxed);
+            if (g != group && other > most) {
+                donor = g;
+                most = other;
+            }
+        }
+        state.donor[q].store(donor, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Move tasks the AICores made ready from the shared resolved queue into
+ * this thread's ready queues, a batch at a time
+ *
+ * @return Number of tasks placed, or -1 if a ready queue overflowed
+ */
+int AicpuExecutor::place_resolved(Runtime& runtime, int thread_idx) {
+    int placed = 0;
+    int claimed[READY_BATCH];
+    int count;
+    while ((count = runtime.claim_resolved(claimed, READY_BATCH)) > 0) {
+        ReadyBatch aic_batch;
+        ReadyBatch aiv_batch;
+        aic_batch.count = 0;
+        aiv_batch.count = 0;
+        for (int k = 0; k < count; k++) {
+            ReadyBatch& batch = queue_of(runtime.sched_at(claimed[k])->core_type) == 0 ? aic_batch : aiv_batch;
+            batch.levels[batch.count] = ready_level(claimed[k]);
+            batch.task_ids[batch.count++] = claimed[k];
+        }
+        bool published = true;
+        if (aic_batch.count > 0) {
+            published &= publish_ready(ready_queues_[thread_idx][0], aic_batch);
+        }
+        if (aiv_batch.count > 0) {
+            published &= publish_ready(ready_queues_[thread_idx][1], aiv_batch);
+        }
+        if (!published) {
+            return -1;
+        }
+        placed += count;
+    }
+    return placed;
+}
+
+/**
+ * Approximate number of ready tasks of one core type across all threads
+ */
+int AicpuExecutor::ready_count(int queue_idx) const {
+    int total = 0;
+    for (int t = 0; t < thread_num_; t++) {
+        total += ready_queues_[t][queue_idx].size();
+    }
+    return total;
+}
+
+/**
+ * Hold a ready task for the block of the core that produced its input
+ *
+ * @return false if the block's buffer is full (publish the task instead)
+ */
+bool AicpuExecutor::hold_for_block(int producer_core, int queue_idx, int task_id, int round) {
+    int block = core_block_[producer_core];
+    AffinityBuffer& buffer = affinity_[block][queue_idx];
+    if (buffer.count == AFFINITY_SLOTS) {
+        return false;
+    }
+    bool producer_is_aic = producer_core < num_aic_;  // AIC core IDs = block IDs
+    bool same_type = producer_is_aic == (queue_idx == 0);
+    AffinityEntry& entry = buffer.entries[buffer.count++];
+    entry.task_id = task_id;
+    entry.core_id = same_type ? producer_core : -1;
+    entry.since = round;
+    return true;
+}
+
+/**
+ * Take a task held for this core's block: the oldest one produced on this
+ * core, else the oldest one in the buffer
+ */
+int AicpuExecutor::take_held(int core_id, int queue_idx, bool* same_core) {
+    AffinityBuffer& buffer = affinity_[core_block_[core_id]][queue_idx];
+    if (buffer.count == 0) {
+        return -1;
+    }
+    int pick = 0;
+    for (int i = 0; i < buffer.count; i++) {
+        if (buffer.entries[i].core_id == core_id) {
+            pick = i;
+            break;
+        }
+    }
+    int task_id = buffer.entries[pick].task_id;
+    *same_core = buffer.entries[pick].core_id == core_id;
+    for (int i = pick + 1; i < buffer.count; i++) {
+        buffer.entries[i - 1] = buffer.entries[i];
+    }
+    buffer.count--;
+    return task_id;
+}
+
+/**
+ * Move held tasks whose wait expired from this thread's block buffers to
+ * its ready queues
+ *
+ * @return false if a ready queue overflowed
+ */
+bool AicpuExecutor::release_held(int thread_idx, int round) {
+    bool ok = true;
+    for (int b = 0; b < num_aic_; b++) {
+        if (block_owner_[b].load(std::memory_order_relaxed) != thread_idx) {
+            continue;
+        }
+        for (int q = 0; q < 2; q++) {
+            AffinityBuffer& buffer = affinity_[b][q];
+            ReadyBatch batch;
+            batch.count = 0;
+            int kept = 0;
+            for (int i = 0; i < buffer.count; i++) {
+                const AffinityEntry& entry = buffer.entries[i];
+                if (round - entry.since >= locality_wait_) {
+                    batch.levels[batch.count] = ready_level(entry.task_id);
+                    batch.task_ids[batch.count++] = entry.task_id;
+                } else {
+                    buffer.entries[kept++] = entry;
+                }
+            }
+            buffer.count = kept;
+            if (batch.count > 0) {
+                ok &= publish_ready(ready_queues_[thread_idx][q], batch);
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * Number of tasks held in this thread's block buffers
+ */
+int AicpuExecutor::held_count(int thread_idx) const {
+    int total = 0;
+    for (int b = 0; b < num_aic_; b++) {
+        if (block_owner_[b].load(std::memory_order_relaxed) == thread_idx) {
+            total += affinity_[b][0].count + affinity_[b][1].count;
+        }
+    }
+    return total;
+}
+
+/**
+ * Tasks completed by all threads: the sum of the shards, or of the group
+ * totals in hierarchical mode (each lags its group by at most one
+ * coordinator round, and reaches the final count before the coordinator
+ * stops)
+ */
+int AicpuExecutor::completed_count() const {
+    int total = 0;
+    if (group_num_ > 1) {
+        for (int g = 0; g < group_num_; g++) {
+            total += groups_[g].completed.load(std::memory_order_acquire);
+        }
+        return total;
+    }
+    for (int t = 0; t < thread_num_; t++) {
+        total += completed_shards_[t].count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+/**
+ * Mailbox slots a core is using: posted tasks not yet completed, plus one
+ * while it runs a chain (a running chain occupies the core like a posted
+ * task)
+ */
+uint32_t AicpuExecutor::core_occupancy(int core_id) const {
+    return core_posted_[core_id] - core_completed_[core_id] + (core_chain_[core_id] >= 0 ? 1 : 0);
+}
+
+/**
+ * Post a task to the next mailbox slot of a core (the caller checked that
+ * the core has a free slot)
+ */
+void AicpuExecutor::post_task(Handshake* hank, int core_id, int task_id, Task* task) {
+    Handshake* h = &hank[core_id];
+    uint32_t posted = core_posted_[core_id];
+    int slot = static_cast<int>(posted % RUNTIME_MAX_MAILBOX_DEPTH);
+    core_task_ids_[core_id][slot] = task_id;
+    h->tasks[slot] = reinterpret_cast<uint64_t>(task);
+    // The slot must be visible before the core sees the new count
+    std::atomic_thread_fence(std::memory_order_release);
+    core_posted_[core_id] = posted + 1;
+    h->post_count = posted + 1;
+    aicpu_wake(&h->wake_word);
+}
+
+/**
+ * Add a completed task's duration to this thread's samples of its kernel
+ */
+void AicpuExecutor::record_duration(int thread_idx, const Task* task) {
+    int func_id = task->func_id;
+    if (func_id < 0 || func_id >= RUNTIME_MAX_FUNC_ID || task->end_time < task->start_time) {
+        return;
+    }
+    FuncSamples& samples = thread_samples_[thread_idx][func_id];
+    double duration = static_cast<double>(task->end_time - task->start_time);
+    samples.count++;
+    samples.sum += duration;
+    samples.sum_sq += duration * duration;
+}
+
+/**
+ * Sum every thread's samples into Runtime::func_samples for the host. Run
+ * by the last thread to finish, after every other thread stopped recording.
+ */
+void AicpuExecutor::publish_samples(Runtime* runtime) {
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        FuncSamples total{};
+        for (int t = 0; t < thread_num_; t++) {
+            total.count += thread_samples_[t][f].count;
+            total.sum += thread_samples_[t][f].sum;
+            total.sum_sq += thread_samples_[t][f].sum_sq;
+        }
+        runtime->func_samples[f] = total;
+    }
+}
+
+/**
+ * Post the MIX task waiting for a block to its AIC and both AIVs once all
+ * three have a free mailbox slot. Posting the whole gang in one step keeps
+ * the MIX tasks of a block in the same order on its three cores, so their
+ * barriers always pair up.
+ *
+ * @return true if the gang was posted
+ */
+bool AicpuExecutor::post_gang(Runtime& runtime, Handshake* hank, int block) {
+    int cores[RUNTIME_MIX_ROLES] = {block, num_aic_ + 2 * block, num_aic_ + 2 * block + 1};
+    for (int k = 0; k < RUNTIME_MIX_ROLES; k++) {
+        if (core_occupancy(cores[k]) >= static_cast<uint32_t>(mailbox_depth_)) {
+            return false;
+        }
+    }
+    int task_id = block_gang_[block];
+    Task* task = runtime.task_at(task_id);
+    for (int k = 0; k < RUNTIME_MIX_ROLES; k++) {
+        post_task(hank, cores[k], task_id, task);
+    }
+    block_gang_[block] = -1;
+    DEV_INFO("Posted MIX task %d to block %d", task_id, block);
+    return true;
+}
+
+/**
+ * Hand one idle block to the thread whose cores complete the most tasks
+ * per block if this thread's rate is under half of it
+ *
+ * A block qualifies when all three cores have nothing posted, no chain
+ * running, every completion processed, and no tasks held or MIX task
+ * waiting for the block.
+ * The block's owner changes as soon as the receiver's inbox takes it, and
+ * its cores leave this thread's slots and free mask; the thread keeps at
+ * least one block.
+ *
+ * @return true if a block was handed over
+ */
+bool AicpuExecutor::donate_block(Runtime& runtime, int thread_idx, uint64_t* free_mask) {
+    // Rates compared as recent / blocks by cross-multiplying; receivers
+    // come from this thread's group
+    int receiver = -1;
+    int receiver_load = 0;
+    int receiver_blocks = 1;
+    int group_first = thread_idx - thread_idx % group_size_;
+    int group_end = group_first + group_size_ < thread_num_ ? group_first + group_size_ : thread_num_;
+    for (int t = group_first; t < group_end; t++) {
+        int load = completed_shards_[t].recent.load(std::memory_order_relaxed);
+        int blocks = completed_shards_[t].blocks.load(std::memory_order_relaxed);
+        bool faster = static_cast<int64_t>(load) * receiver_blocks > static_cast<int64_t>(receiver_load) * blocks;
+        if (t != thread_idx && blocks > 0 && (receiver < 0 || faster)) {
+            receiver = t;
+            receiver_load = load;
+            receiver_blocks = blocks;
+        }
+    }
+    int my_load = completed_shards_[thread_idx].recent.load(std::memory_order_relaxed);
+    int my_blocks = completed_shards_[thread_idx].blocks.load(std::memory_order_relaxed);
+    if (receiver < 0 || my_blocks < 2 || receiver_load < REBALANCE_MIN_LOAD ||
+        2 * static_cast<int64_t>(my_load) * receiver_blocks >= static_cast<int64_t>(receiver_load) * my_blocks) {
+        return false;
+    }
+
+    Handshake* hank = (Handshake*)runtime.workers;
+    ThreadSlots& slots = thread_slots_[thread_idx];
+    int owned_blocks = 0;
+    int candidate = -1;
+    for (int b = 0; b < num_aic_; b++) {
+        if (block_owner_[b].load(std::memory_order_relaxed) != thread_idx) {
+            continue;
+        }
+        owned_blocks++;
+        int cores[3] = {b, num_aic_ + 2 * b, num_aic_ + 2 * b + 1};
+        bool idle = affinity_[b][0].count == 0 && affinity_[b][1].count == 0 && block_gang_[b] < 0;
+        for (int k = 0; k < 3 && idle; k++) {
+            idle = core_occupancy(cores[k]) == 0 && hank[cores[k]].done_count == core_executed_[cores[k]];
+        }
+        if (idle && candidate < 0) {
+            candidate = b;
+        }
+    }
+    if (owned_blocks < 2 || candidate < 0) {
+        return false;
+    }
+
+    int expected = INBOX_EMPTY;
+    if (!inboxes_[receiver].block.compare_exchange_strong(expected, candidate, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+        return false;  // Receiver busy adopting another block, or done
+    }
+    block_owner_[candidate].store(receiver, std::memory_order_relaxed);
+    completed_shards_[thread_idx].blocks.store(owned_blocks - 1, std::memory_order_relaxed);
+    int cores[3] = {candidate, num_aic_ + 2 * candidate, num_aic_ + 2 * candidate + 1};
+    for (int i = 0; i < slots.used; i++) {
+        for (int k = 0; k < 3; k++) {
+            if (slots.cores[i] == cores[k]) {
+                slots.cores[i] = -1;
+                free_mask[i / 64] &= ~(1ULL << (i % 64));
+            }
+        }
+    }
+    DEV_INFO("Thread %d: Handed block %d to thread %d (%d completions on %d blocks vs %d on %d)", thread_idx,
+        candidate, receiver, my_load, my_blocks, receiver_load, receiver_blocks);
+    return true;
+}
+
+/**
+ * Take over a block handed to this thread: give its cores free slots (and
+ * doorbell bits) before the first task is posted to them
+ *
+ * @param free_mask  Free-slot mask to mark the cores in, or nullptr when
+ *                   the thread is no longer dispatching
+ */
+void AicpuExecutor::adopt_block(Runtime& runtime, int thread_idx, int block, uint64_t* free_mask) {
+    Handshake* hank = (Handshake*)runtime.workers;
+    ThreadSlots& slots = thread_slots_[thread_idx];
+    int cores[3] = {block, num_aic_ + 2 * block, num_aic_ + 2 * block + 1};
+    int i = 0;
+    for (int k = 0; k < 3; k++) {
+        while (i < slots.used && slots.cores[i] >= 0) {
+            i++;
+        }
+        if (i == slots.used) {
+            slots.used++;
+        }
+        slots.cores[i] = cores[k];
+        hank[cores[k]].doorbell_word = slots.doorbell_base + i / 64;
+        hank[cores[k]].doorbell_mask = 1ULL << (i % 64);
+        if (free_mask != nullptr) {
+            free_mask[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+    // The new doorbell bits must be visible before any task is posted
+    std::atomic_thread_fence(std::memory_order_release);
+    completed_shards_[thread_idx].blocks.fetch_add(1, std::memory_order_relaxed);
+    DEV_INFO("Thread %d: Adopted block %d", thread_idx, block);
+}
+
+/**
+ * Size the scheduler state for this launch's threads, groups, blocks,
+ * cores and core slots, growing every array that is too small
+ *
+ * @param slot_count  Core slots of all threads together
+ * @return false on allocation failure
+ */
+bool AicpuExecutor::reserve_storage(int slot_count) {
+    if (thread_num_ > thread_capacity_) {
+        thread_capacity_ = 0;
+        if (!allocate(thread_slots_, thread_num_) || !allocate(inboxes_, thread_num_) ||
+            !allocate(ready_queues_, thread_num_) || !allocate(completed_shards_, thread_num_) ||
+            !allocate(thread_samples_, thread_num_)) {
+            return false;
+        }
+        thread_capacity_ = thread_num_;
+    }
+    if (group_num_ > group_capacity_) {
+        group_capacity_ = 0;
+        if (!allocate(groups_, group_num_)) {
+            return false;
+        }
+        group_capacity_ = group_num_;
+    }
+    if (num_aic_ > block_capacity_) {
+        block_capacity_ = 0;
+        if (!allocate(block_owner_, num_aic_) || !allocate(affinity_, num_aic_) || !allocate(block_gang_, num_aic_)) {
+            return false;
+        }
+        block_capacity_ = num_aic_;
+    }
+    if (cores_total_num_ > core_capacity_) {
+        core_capacity_ = 0;
+        if (!allocate(core_task_ids_, cores_total_num_) || !allocate(core_posted_, cores_total_num_) ||
+            !allocate(core_completed_, cores_total_num_) || !allocate(core_executed_, cores_total_num_) ||
+            !allocate(core_chain_, cores_total_num_) || !allocate(core_block_, cores_total_num_)) {
+            return false;
+        }
+        core_capacity_ = cores_total_num_;
+    }
+    if (slot_count > slot_capacity_) {
+        slot_capacity_ = 0;
+        if (!allocate(core_slots_, slot_count)) {
+            return false;
+        }
+        slot_capacity_ = slot_count;
+    }
+    return true;
+}
+
 int AicpuExecutor::init(Runtime* runtime) {
     bool expected = false;
     if (!initialized_.compare_exchange_strong(expected, true, std::memory_order_acq_rel, std::memory_order_acquire)) {
@@ -69,60 +802,111 @@ int AicpuExecutor::init(Runtime* runtime) {
 
     // Read execution parameters from runtime
     thread_num_ = runtime->sche_cpu_num;
-    if (thread_num_ == 0) thread_num_ = 1;
+    num_aic_ = runtime->block_dim;  // Total AIC cores (= block_dim)
+    cores_total_num_ = runtime->block_dim * blockdim_cores_num_;
 
-    if (thread_num_ < 1 || thread_num_ > MAX_AICPU_THREADS) {
-        DEV_ERROR("Invalid thread_num: %d", thread_num_);
+    // Validate block distribution: every thread needs a block, and the host
+    // must have sized the handshakes and doorbells for this topology
+    if (thread_num_ < 1 || thread_num_ > num_aic_) {
+        DEV_ERROR("Invalid thread_num: %d (must be 1..block_dim %d)", thread_num_, num_aic_);
         init_failed_.store(true, std::memory_order_release);
         return -1;
     }
-
-    cores_total_num_ = runtime->block_dim * blockdim_cores_num_;
-    thread_cores_num_ = cores_total_num_ / thread_num_;
-
-    if (cores_total_num_ > MAX_CORES_PER_THREAD) {
-        DEV_ERROR("Total cores %d exceeds maximum %d", cores_total_num_, MAX_CORES_PER_THREAD);
+    if (runtime->worker_count != cores_total_num_ || runtime->thread_doorbell_base(thread_num_) > runtime->doorbell_count) {
+        DEV_ERROR("Handshake storage (%d workers, %d doorbell words) does not fit %d blocks on %d threads",
+            runtime->worker_count, runtime->doorbell_count, num_aic_, thread_num_);
         init_failed_.store(true, std::memory_order_release);
         return -1;
     }
 
-    DEV_INFO("Config: threads=%d, cores=%d, cores_per_thread=%d", thread_num_, cores_total_num_, thread_cores_num_);
+    mailbox_depth_ = runtime->mailbox_depth;
+    if (mailbox_depth_ < 1 || mailbox_depth_ > RUNTIME_MAX_MAILBOX_DEPTH) {
+        DEV_ERROR("Invalid mailbox_depth: %d (must be 1..%d)", mailbox_depth_, RUNTIME_MAX_MAILBOX_DEPTH);
+        init_failed_.store(true, std::memory_order_release);
+        return -1;
+    }
+    chain_successors_ = runtime->chain_successors != 0 && runtime->chain_next != nullptr;
+    chain_next_ = runtime->chain_next;
+
+    rebalance_ = runtime->rebalance_cores != 0 && thread_num_ > 1;
+    group_size_ = runtime->sched_group_size > 1 && runtime->sched_group_size < thread_num_ ? runtime->sched_group_size
+                                                                                           : thread_num_;
+    group_num_ = (thread_num_ + group_size_ - 1) / group_size_;
+    int slot_count = 0;
+    for (int t = 0; t < thread_num_; t++) {
+        slot_count += runtime->thread_slot_capacity(t);
+    }
+    if (!reserve_storage(slot_count)) {
+        DEV_ERROR("Failed to allocate scheduler state for %d threads and %d cores", thread_num_, cores_total_num_);
+        init_failed_.store(true, std::memory_order_release);
+        return -1;
+    }
+    for (int i = 0; i < cores_total_num_; i++) {
+        core_posted_[i] = 0;
+        core_completed_[i] = 0;
+        core_executed_[i] = 0;
+        core_chain_[i] = -1;
+    }
+    for (int g = 0; g < group_num_; g++) {
+        groups_[g].completed.store(0, std::memory_order_relaxed);
+        for (int q = 0; q < 2; q++) {
+            groups_[g].ready[q].store(0, std::memory_order_relaxed);
+            groups_[g].donor[q].store(-1, std::memory_order_relaxed);
+        }
+    }
+    DEV_INFO("Config: threads=%d in %d group(s), cores=%d, mailbox_depth=%d, rebalance=%d", thread_num_, group_num_,
+        cores_total_num_, mailbox_depth_, rebalance_ ? 1 : 0);
 
     // Pre-compute core assignments for each thread
-    // Each thread manages blocks_per_thread blocks
+    // Thread t manages blocks [t * block_dim / threads, (t + 1) * block_dim / threads)
     // For each block b: AIC is core b, AIVs are cores (nrAic + b*2) and (nrAic
     // + b*2 + 1)
-    int num_aic = runtime->block_dim;  // Total AIC cores (= block_dim)
-    int blocks_per_thread = runtime->block_dim / thread_num_;
+    int num_aic = num_aic_;
 
-    // Validate block distribution
-    if (runtime->block_dim % thread_num_ != 0) {
-        DEV_ERROR("block_dim (%d) must be divisible by thread_num (%d)", runtime->block_dim, thread_num_);
-        init_failed_.store(true, std::memory_order_release);
-        return -1;
-    }
-
-    DEV_INFO("Block assignment: %d blocks, %d threads, %d blocks per thread",
+    DEV_INFO("Block assignment: %d blocks, %d threads, %d-%d blocks per thread",
         runtime->block_dim,
         thread_num_,
-        blocks_per_thread);
+        runtime->block_dim / thread_num_,
+        (runtime->block_dim + thread_num_ - 1) / thread_num_);
 
+    int slot_base = 0;
     for (int t = 0; t < thread_num_; t++) {
-        int start_block = t * blocks_per_thread;
-        int end_block = (t + 1) * blocks_per_thread;
+        int start_block = runtime->thread_first_block(t);
+        int end_block = runtime->thread_first_block(t + 1);
+        int capacity = runtime->thread_slot_capacity(t);
+        ThreadSlots& slots = thread_slots_[t];
+        slots.cores = &core_slots_[slot_base];
+        slots.doorbell_base = runtime->thread_doorbell_base(t);
+        slots.words = (capacity + 63) / 64;
+        slot_base += capacity;
         int core_idx = 0;
+        inboxes_[t].block.store(INBOX_EMPTY, std::memory_order_relaxed);
+        completed_shards_[t].count.store(0, std::memory_order_release);
+        completed_shards_[t].recent.store(0, std::memory_order_relaxed);
+        completed_shards_[t].blocks.store(end_block - start_block, std::memory_order_relaxed);
+        for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+            thread_samples_[t][f] = FuncSamples{};
+        }
 
         // Assign AIC cores for all blocks managed by this thread
         for (int b = start_block; b < end_block; b++) {
-            core_assignments_[t][core_idx++] = b;  // AIC core ID = block ID
+            slots.cores[core_idx++] = b;  // AIC core ID = block ID
+            core_block_[b] = b;
+            affinity_[b][0].count = 0;
+            affinity_[b][1].count = 0;
+            block_gang_[b] = -1;
+            block_owner_[b].store(t, std::memory_order_relaxed);
         }
 
         // Assign AIV cores for all blocks managed by this thread
         for (int b = start_block; b < end_block; b++) {
-            int aiv_base = num_aic;                                   // AIV cores start after all AIC cores
-            core_assignments_[t][core_idx++] = aiv_base + b * 2;      // First AIV of block b
-            core_assignments_[t][core_idx++] = aiv_base + b * 2 + 1;  // Second AIV of block b
+            int aiv_base = num_aic;                          // AIV cores start after all AIC cores
+            slots.cores[core_idx++] = aiv_base + b * 2;      // First AIV of block b
+            slots.cores[core_idx++] = aiv_base + b * 2 + 1;  // Second AIV of block b
+            core_block_[aiv_base + b * 2] = b;
+            core_block_[aiv_base + b * 2 + 1] = b;
         }
+        slots.used = core_idx;
 
         DEV_INFO(
             "Thread %d: manages blockDims [%d-%d], cores: AIC[%d-%d] "
@@ -137,28 +921,100 @@ int AicpuExecutor::init(Runtime* runtime) {
     }
 
     // Initialize runtime execution state
-    total_tasks_.store(runtime->get_task_count(), std::memory_order_release);
-    completed_tasks_.store(0, std::memory_order_release);
+    int task_count = runtime->get_task_count();
+    total_tasks_.store(task_count, std::memory_order_release);
+
+    // Undo the fanin decrements of any previous launch of this graph
+    runtime->reset_fanin();
+    runtime->reset_resolved();
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        runtime->func_samples[f] = FuncSamples{};
+    }
+    for (int w = 0; w < runtime->doorbell_count; w++) {
+        runtime->doorbells[w].bits.store(0, std::memory_order_relaxed);
+    }
+    resolve_on_aicore_ = runtime->resolve_on_aicore != 0;
+
+    // The orchestration's order and placement, unless the launch names a
+    // policy
+    placement_policy_ = runtime->placement_policy;
+    locality_wait_ = runtime->locality_wait;
+    if (placement_policy_ != PLACEMENT_ANY && placement_policy_ != PLACEMENT_LOCALITY) {
+        DEV_ERROR("Invalid placement_policy: %d", placement_policy_);
+        init_failed_.store(true, std::memory_order_release);
+        return -1;
+    }
+    if (locality_wait_ < 0) {
+        locality_wait_ = 0;
+    }
+    switch (runtime->sched_policy) {
+        case RUNTIME_SCHED_GRAPH:
+            policy_ = runtime->schedule_by_rank != 0 ? static_cast<SchedPolicy*>(&critical_path_policy_)
+                                                     : static_cast<SchedPolicy*>(&fifo_policy_);
+            break;
+        case RUNTIME_SCHED_FIFO: policy_ = &fifo_policy_; break;
+        case RUNTIME_SCHED_LIFO: policy_ = &lifo_policy_; break;
+        case RUNTIME_SCHED_CRITICAL_PATH: policy_ = &critical_path_policy_; break;
+        case RUNTIME_SCHED_SHORTEST_JOB: policy_ = &shortest_job_policy_; break;
+        case RUNTIME_SCHED_LOCALITY: policy_ = &locality_policy_; break;
+        default:
+            DEV_ERROR("Invalid sched_policy: %d", runtime->sched_policy);
+            init_failed_.store(true, std::memory_order_release);
+            return -1;
+    }
+    if (runtime->sched_policy != RUNTIME_SCHED_GRAPH) {
+        placement_policy_ = policy_->prefer_locality() ? PLACEMENT_LOCALITY : PLACEMENT_ANY;
+    }
+    if (!policy_->prepare(*runtime)) {
+        DEV_ERROR("Scheduling policy %s cannot schedule this graph", policy_->name());
+        init_failed_.store(true, std::memory_order_release);
+        return -1;
+    }
 
-    int initial_ready[RUNTIME_MAX_TASKS];
+    // Size every level of each thread's queues to the tasks that map to it
+    int aic_levels[READY_LEVELS] = {0};
+    int aiv_levels[READY_LEVELS] = {0};
+    for (int i = 0; i < task_count; i++) {
+        if (queue_of(runtime->sched_at(i)->core_type) == 0) {
+            aic_levels[ready_level(i)]++;
+        } else {
+            aiv_levels[ready_level(i)]++;
+        }
+    }
+    for (int t = 0; t < thread_num_; t++) {
+        if (!ready_queues_[t][0].reset(aic_levels) || !ready_queues_[t][1].reset(aiv_levels)) {
+            DEV_ERROR("Failed to allocate ready queues of thread %d for %d tasks", t, task_count);
+            init_failed_.store(true, std::memory_order_release);
+            return -1;
+        }
+    }
+
+    if (static_cast<int>(initial_ready_.size()) < task_count) {
+        initial_ready_.resize(task_count);
+    }
+    int* initial_ready = initial_ready_.data();
     int initial_count = runtime->get_initial_ready_tasks(initial_ready);
 
     DEV_INFO("Init: Found %d initially ready tasks", initial_count);
 
+    // Deal the initial ready tasks round-robin so every thread starts with
+    // local work
     int aic_count = 0;
     int aiv_count = 0;
     for (int i = 0; i < initial_count; i++) {
-        Task* task = runtime->get_task(initial_ready[i]);
-        if (task->core_type == 0) {  // AIC
-            ready_queue_aic_[aic_count++] = initial_ready[i];
+        int task_id = initial_ready[i];
+        if (queue_of(runtime->sched_at(task_id)->core_type) == 0) {  // AIC or MIX
+            ready_queues_[aic_count % thread_num_][0].push_bulk(ready_level(task_id), &task_id, 1);
+            aic_count++;
         } else {  // AIV
-            ready_queue_aiv_[aiv_count++] = initial_ready[i];
+            ready_queues_[aiv_count % thread_num_][1].push_bulk(ready_level(task_id), &task_id, 1);
+            aiv_count++;
         }
     }
-    ready_count_aic_.store(aic_count, std::memory_order_release);
-    ready_count_aiv_.store(aiv_count, std::memory_order_release);
 
-    DEV_INFO("Init: Initial ready tasks: AIC=%d, AIV=%d", aic_count, aiv_count);
+    DEV_INFO("Init: Initial ready tasks: AIC=%d, AIV=%d (%s policy, resolved on %s, %s placement)", aic_count,
+        aiv_count, policy_->name(), resolve_on_aicore_ ? "AICore" : "AICPU",
+        placement_policy_ == PLACEMENT_LOCALITY ? "locality" : "any-core");
 
     finished_count_.store(0, std::memory_order_release);
 
@@ -173,19 +1029,36 @@ int AicpuExecutor::init(Runtime* runtime) {
 int AicpuExecutor::hank_aicore(Runtime* runtime, int thread_idx, const int* cur_thread_cores) {
     Handshake* all_hanks = (Handshake*)runtime->workers;
 
-    DEV_INFO("Thread %d: Handshaking with %d cores", thread_idx, thread_cores_num_);
+    const ThreadSlots& slots = thread_slots_[thread_idx];
+    int core_num = slots.used;
+    DEV_INFO("Thread %d: Handshaking with %d cores", thread_idx, core_num);
 
-    for (int i = 0; i < thread_cores_num_; i++) {
+    // Bit i of this thread's doorbell words belongs to its i-th core; the
+    // assignment (and the core's MIX role) must be visible before the core
+    // sees aicpu_ready
+    for (int i = 0; i < core_num; i++) {
+        int core_id = cur_thread_cores[i];
+        Handshake* hank = &all_hanks[core_id];
+        hank->doorbell_word = slots.doorbell_base + i / 64;
+        hank->doorbell_mask = 1ULL << (i % 64);
+        int block = core_block_[core_id];
+        hank->mix_role = core_id < num_aic_ ? 0 : 1 + (core_id - num_aic_) % 2;
+        hank->mix_leader = block;  // AIC core ID = block ID
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < core_num; i++) {
         int core_id = cur_thread_cores[i];
         Handshake* hank = &all_hanks[core_id];
         DEV_INFO("Thread %d: AICPU hank addr = 0x%lx", thread_idx, (uint64_t)hank);
         hank->aicpu_ready = 1;
+        aicpu_wake(&hank->wake_word);
     }
 
-    for (int i = 0; i < thread_cores_num_; i++) {
+    for (int i = 0; i < core_num; i++) {
         int core_id = cur_thread_cores[i];
         Handshake* hank = &all_hanks[core_id];
         while (hank->aicore_done == 0) {
+            aicpu_spin_pause();
         }
         DEV_INFO("Thread %d: success hank->aicore_done = %u", thread_idx, hank->aicore_done);
     }
@@ -198,13 +1071,25 @@ int AicpuExecutor::hank_aicore(Runtime* runtime, int thread_idx, const int* cur_
 int AicpuExecutor::shutdown_aicore(Runtime* runtime, int thread_idx, const int* cur_thread_cores) {
     Handshake* all_hanks = (Handshake*)runtime->workers;
 
-    DEV_INFO("Thread %d: Shutting down %d cores", thread_idx, thread_cores_num_);
+    // Take over a block still on its way to this thread, then refuse any
+    // more: this thread shuts down every core it owns
+    int block = inboxes_[thread_idx].block.exchange(INBOX_CLOSED, std::memory_order_acq_rel);
+    if (block >= 0) {
+        adopt_block(*runtime, thread_idx, block, nullptr);
+    }
+
+    int core_num = thread_slots_[thread_idx].used;
+    DEV_INFO("Thread %d: Shutting down %d core slots", thread_idx, core_num);
 
-    for (int i = 0; i < thread_cores_num_; i++) {
+    for (int i = 0; i < core_num; i++) {
         int core_id = cur_thread_cores[i];
+        if (core_id < 0) {
+            continue;  // Handed to another thread
+        }
         Handshake* hank = &all_hanks[core_id];
         DEV_INFO("Thread %d: AICPU hank addr = 0x%lx", thread_idx, (uint64_t)hank);
         hank->control = 1;
+        aicpu_wake(&hank->wake_word);
     }
     DEV_INFO("Thread %d: Shutdown complete", thread_idx);
     return 0;
@@ -214,41 +1099,71 @@ int AicpuExecutor::shutdown_aicore(Runtime* runtime, int thread_idx, const int*
  * Resolve dependencies and dispatch tasks using polling-based dispatch to
  * AICore
  */
-int AicpuExecutor::resolve_and_dispatch(Runtime& runtime, int thread_idx, const int* cur_thread_cores, int core_num) {
+int AicpuExecutor::resolve_and_dispatch(Runtime& runtime, int thread_idx, const int* cur_thread_cores) {
     Handshake* hank = (Handshake*)runtime.workers;
+    const ThreadSlots& slots = thread_slots_[thread_idx];
+    int core_num = slots.used;  // Slots in use, grows when a block is adopted
 
     DEV_INFO("Thread %d: Starting execution with %d cores", thread_idx, core_num);
 
     int cur_thread_completed = 0;
+    int cur_thread_stolen = 0;
+    int cur_thread_chained = 0;
+    int cur_thread_same_core = 0;
+    int cur_thread_same_block = 0;
     int cur_thread_tasks_in_flight = 0;
+    int round = 0;
+    bool locality = placement_policy_ == PLACEMENT_LOCALITY && !resolve_on_aicore_;
+    int published_completed = 0;
+    int window_start_completed = 0;  // This thread's completions when the window opened
+    int window_start_total = 0;      // All threads' completions when the window opened
+
+    // Bit i (of word i / 64) stands for cur_thread_cores[i]. free_mask marks
+    // the cores with a free mailbox slot, so dispatch visits only those.
+    // Every word is visited since adopted cores may use any slot.
+    int mask_words = slots.words;
+    std::vector<uint64_t> free_mask(mask_words, 0);
+    for (int i = 0; i < core_num; i++) {
+        free_mask[i / 64] |= 1ULL << (i % 64);
+    }
     int task_count = total_tasks_.load(std::memory_order_acquire);
 
     // Timeout detection using idle iteration counting
     int idle_iterations = 0;
     const int MAX_IDLE_ITERATIONS = 1000000;
     const int WARN_INTERVAL = 100000;
+    // A MIX gang finishes only once all three cores of its block have run to
+    // the gang barrier, which can take many rounds when the simulated cores
+    // share host CPUs, so rounds spent waiting on one count at this stride
+    const int GANG_IDLE_STRIDE = 16;
+    // Idle waiting (Runtime::idle_wait): consecutive idle rounds, and the
+    // token of sched_wake while armed (0 if not). A blocked wait that times
+    // out, i.e. nothing in the runtime progressed meanwhile, counts as this
+    // many idle iterations.
+    const int IDLE_BLOCK_ITERATIONS = 1000;
+    int idle_rounds = 0;
+    uint32_t armed = 0;
+    int cur_thread_gangs = 0;  // MIX tasks posted and not yet completed
     bool made_progress = false;
 
-    int verification_warning_count = 0;
-    const int MAX_VERIFICATION_WARNINGS = 10;
+    bool verification_warned = false;
 
     // Execute tasks using polling-based dispatch with integrated verification
     while (true) {
         // Double verification: check counter reached AND all cores truly idle
-        if (completed_tasks_.load(std::memory_order_acquire) >= task_count) {
+        if (completed_count() >= task_count) {
             bool all_cores_idle = true;
 
             for (int i = 0; i < core_num; i++) {
                 int core_id = cur_thread_cores[i];
-                Handshake* h = &hank[core_id];
 
-                if (h->task_status != 0 || h->task != 0) {
+                if (core_id >= 0 && core_occupancy(core_id) != 0) {
                     all_cores_idle = false;
 
-                    if (verification_warning_count == 0) {
-                        DEV_WARN("Thread %d: Counter reached %d/%d but core %d still has work (status=%d, task=%p)",
-                                thread_idx, completed_tasks_.load(std::memory_order_acquire), task_count,
-                                core_id, h->task_status, (void*)h->task);
+                    if (!verification_warned) {
+                        DEV_WARN("Thread %d: Counter reached %d/%d but core %d still has work (posted=%u, done=%u)",
+                                thread_idx, completed_count(), task_count,
+                                core_id, core_posted_[core_id], hank[core_id].done_count);
                     }
                     break;
                 }
@@ -256,8 +1171,8 @@ int AicpuExecutor::resolve_and_dispatch(Runtime& runtime, int thread_idx, const
 
             if (all_cores_idle) {
                 // Truly complete: counter reached and all cores idle
-                int aic_remaining = ready_count_aic_.load(std::memory_order_acquire);
-                int aiv_remaining = ready_count_aiv_.load(std::memory_order_acquire);
+                int aic_remaining = ready_count(0);
+                int aiv_remaining = ready_count(1);
                 if (aic_remaining > 0 || aiv_remaining > 0) {
                     DEV_WARN("Thread %d: Queues not empty after completion! AIC=%d, AIV=%d",
                             thread_idx, aic_remaining, aiv_remaining);
@@ -265,123 +1180,272 @@ int AicpuExecutor::resolve_and_dispatch(Runtime& runtime, int thread_idx, const
                 break;  // Exit main loop
             }
 
-            // Counter reached but cores still working, continue main loop to process them
-            verification_warning_count++;
-            if (verification_warning_count > MAX_VERIFICATION_WARNINGS) {
-                DEV_ERROR("Thread %d: Counter reached but cores still working after %d checks!",
-                         thread_idx, verification_warning_count);
-                diagnose_stuck_state(runtime, thread_idx, cur_thread_cores, core_num, hank);
-                return -1;
-            }
+            // Counter reached but cores still working, continue main loop to
+            // process them. The AIV cores of a MIX task report done only
+            // after its leader completed it, as late as the host schedules
+            // their threads, so only the idle timeout below gives up on them.
+            verification_warned = true;
         }
 
         made_progress = false;
+        round++;
+
+        // Phase 1: Process completed tasks on the cores that rang their
+        // doorbell bit since the last poll
+        for (int w = 0; w < mask_words; w++) {
+            Doorbell& doorbell = runtime.doorbells[slots.doorbell_base + w];
+            uint64_t rung = doorbell.bits.load(std::memory_order_relaxed) != 0
+                                ? doorbell.bits.exchange(0, std::memory_order_acquire)
+                                : 0;
+            while (rung != 0) {
+                int i = w * 64 + __builtin_ctzll(rung);
+                rung &= rung - 1;
+                int core_id = i < core_num ? cur_thread_cores[i] : -1;
+                if (core_id < 0) {
+                    continue;  // Late ring from a core since handed away
+                }
+                Handshake* h = &hank[core_id];
+
+                // Core finished one or more tasks since the last poll. It runs
+                // each posted task followed by its chain successors, so the
+                // completions are replayed in that same order.
+                uint32_t done = h->done_count;
+                while (core_executed_[core_id] != done) {
+                    int task_id = core_chain_[core_id];
+                    if (task_id >= 0) {
+                        cur_thread_chained++;
+                    } else {
+                        task_id = core_task_ids_[core_id][core_completed_[core_id] % RUNTIME_MAX_MAILBOX_DEPTH];
+                        core_completed_[core_id]++;
+                        cur_thread_tasks_in_flight--;
+                    }
+                    core_executed_[core_id]++;
+                    TaskSched* sched = runtime.sched_at(task_id);
+
+                    // An AIV's share of a MIX task only frees its slot: the
+                    // AIC reports the task for the gang, and the gang
+                    // barrier keeps it from finishing before the AIVs
+                    if (sched->core_type == static_cast<int>(CoreType::MIX)) {
+                        if (core_id >= num_aic_) {
+                            made_progress = true;
+                            continue;
+                        }
+                        cur_thread_gangs--;
+                    }
+                    record_duration(thread_idx, runtime.task_at(task_id));
+                    int chain_id = chain_successors_ ? chain_next_[task_id] : -1;
+                    core_chain_[core_id] = chain_id;
+
+                    DEV_INFO("Thread %d: Core %d completed task %d%s", thread_idx, core_id, task_id,
+                        chain_id >= 0 ? ", chaining its successor" : "");
+
+                    // The core already resolved the successors itself
+                    if (resolve_on_aicore_) {
+                        cur_thread_completed++;
+                        made_progress = true;
+                        continue;
+                    }
 
-        // Phase 1: Process completed tasks on my managed cores
-        for (int i = 0; i < core_num; i++) {
-            int core_id = cur_thread_cores[i];
-            Handshake* h = &hank[core_id];
-
-            // Core finished a task (idle + task not null)
-            if (h->task_status == 0 && h->task != 0) {
-                // Get completed task and immediately clear the pointer to prevent duplicate detection
-                Task* task = reinterpret_cast<Task*>(h->task);
-                h->task = 0;  // Clear immediately to minimize race condition window
-
-                int task_id = task->task_id;
-
-                DEV_INFO("Thread %d: Core %d completed task %d", thread_idx, core_id, task_id);
-
-                // Update fanin of successors atomically and add to appropriate
-                // shared ready queue
-                for (int j = 0; j < task->fanout_count; j++) {
-                    int dep_id = task->fanout[j];
-                    Task* dep = runtime.get_task(dep_id);
-
-                    // Atomic decrement fanin
-                    int prev_fanin = dep->fanin.fetch_sub(1, std::memory_order_acq_rel);
-
-                    // Dependency resolved, add to appropriate shared ready
-                    // queue
-                    if (prev_fanin == 1) {
-                        if (dep->core_type == 0) {  // AIC task
-                            std::lock_guard<std::mutex> lock(ready_queue_aic_mutex_);
-                            int idx = ready_count_aic_.load(std::memory_order_relaxed);
-                            ready_queue_aic_[idx] = dep_id;
-                            ready_count_aic_.fetch_add(1, std::memory_order_release);
-                            DEV_INFO("Thread %d: Task %d became ready -> AIC queue", thread_idx, dep_id);
-                        } else {  // AIV task
-                            std::lock_guard<std::mutex> lock(ready_queue_aiv_mutex_);
-                            int idx = ready_count_aiv_.load(std::memory_order_relaxed);
-                            ready_queue_aiv_[idx] = dep_id;
-                            ready_count_aiv_.fetch_add(1, std::memory_order_release);
-                            DEV_INFO("Thread %d: Task %d became ready -> AIV queue", thread_idx, dep_id);
+                    // Update fanin of successors atomically; the ones that become
+                    // ready are batched per core type and published in bulk to
+                    // this thread's own ready queues (successor IDs are
+                    // contiguous in the CSR edge array)
+                    ReadyBatch aic_batch;
+                    ReadyBatch aiv_batch;
+                    aic_batch.count = 0;
+                    aiv_batch.count = 0;
+                    bool published = true;
+                    const int* fanout = runtime.get_fanout(sched);
+                    for (int j = 0; j < sched->fanout_count; j++) {
+                        int dep_id = fanout[j];
+                        TaskSched* dep = runtime.sched_at(dep_id);
+
+                        // Atomic decrement fanin
+                        int prev_fanin = dep->fanin.fetch_sub(1, std::memory_order_acq_rel);
+
+                        // Dependency resolved, hold it for this block or add it
+                        // to the matching batch, unless the core is already
+                        // running it as a chain successor
+                        if (prev_fanin == 1 && dep_id != chain_id) {
+                            bool is_aic = queue_of(dep->core_type) == 0;
+                            if (locality && hold_for_block(core_id, is_aic ? 0 : 1, dep_id, round)) {
+                                DEV_INFO("Thread %d: Task %d became ready -> held for block %d", thread_idx, dep_id,
+                                    core_block_[core_id]);
+                                continue;
+                            }
+                            ReadyBatch& batch = is_aic ? aic_batch : aiv_batch;
+                            if (batch.count == READY_BATCH) {
+                                published &= publish_ready(ready_queues_[thread_idx][is_aic ? 0 : 1], batch);
+                            }
+                            batch.levels[batch.count] = ready_level(dep_id);
+                            batch.task_ids[batch.count++] = dep_id;
+                            DEV_INFO("Thread %d: Task %d became ready -> %s queue", thread_idx, dep_id,
+                                is_aic ? "AIC" : "AIV");
                         }
                     }
+                    if (aic_batch.count > 0) {
+                        published &= publish_ready(ready_queues_[thread_idx][0], aic_batch);
+                    }
+                    if (aiv_batch.count > 0) {
+                        published &= publish_ready(ready_queues_[thread_idx][1], aiv_batch);
+                    }
+                    if (!published) {
+                        diagnose_stuck_state(runtime, thread_idx, cur_thread_cores, core_num, hank);
+                        return -1;
+                    }
+
+                    // Update counters
+                    cur_thread_completed++;
+                    made_progress = true;
+                }
+                if (core_occupancy(core_id) < static_cast<uint32_t>(mailbox_depth_)) {
+                    free_mask[w] |= 1ULL << (i % 64);
                 }
+            }
+        }
+        if (cur_thread_completed != published_completed) {
+            completed_shards_[thread_idx].count.store(cur_thread_completed, std::memory_order_release);
+            published_completed = cur_thread_completed;
+        }
+        if (group_num_ > 1 && thread_idx % group_size_ == 0) {
+            coordinate_group(thread_idx);
+        }
 
-                // Update counters
-                cur_thread_tasks_in_flight--;
-                cur_thread_completed++;
+        // Core rebalancing, between completion and dispatch so a block whose
+        // tasks just finished can be shed instead of refilled: publish this
+        // window's rate, hand an idle block to a much faster thread, and take
+        // over any block handed here
+        if (rebalance_) {
+            int total_completed = completed_count();
+            if (total_completed - window_start_total >= REBALANCE_WINDOW) {
+                completed_shards_[thread_idx].recent.store(cur_thread_completed - window_start_completed,
+                    std::memory_order_relaxed);
+                window_start_completed = cur_thread_completed;
+                window_start_total = total_completed;
+                donate_block(runtime, thread_idx, free_mask.data());
+            }
+            if (inboxes_[thread_idx].block.load(std::memory_order_relaxed) >= 0) {
+                int block = inboxes_[thread_idx].block.exchange(INBOX_EMPTY, std::memory_order_acq_rel);
+                adopt_block(runtime, thread_idx, block, free_mask.data());
+                core_num = slots.used;
                 made_progress = true;
-                completed_tasks_.fetch_add(1, std::memory_order_release);
             }
         }
 
-        // Load balancing: Skip dispatch if all my cores are busy
-        if (cur_thread_tasks_in_flight < core_num) {
-            // Phase 2: Dispatch new tasks from matching ready queue to idle cores
-            for (int i = 0; i < core_num; i++) {
-                int core_id = cur_thread_cores[i];
-                Handshake* h = &hank[core_id];
+        // Placement of tasks the AICores resolved
+        if (resolve_on_aicore_) {
+            int placed = place_resolved(runtime, thread_idx);
+            if (placed < 0) {
+                diagnose_stuck_state(runtime, thread_idx, cur_thread_cores, core_num, hank);
+                return -1;
+            }
+            if (placed > 0) {
+                made_progress = true;
+            }
+        }
 
-                // Core is idle and available (idle + task is null)
-                if (h->task_status == 0 && h->task == 0) {
-                    // Dispatch from matching queue based on core type
-                    if (h->core_type == 0) {  // AIC core
-                        if (ready_count_aic_.load(std::memory_order_acquire) > 0) {
-                            std::lock_guard<std::mutex> lock(ready_queue_aic_mutex_);
-                            int count = ready_count_aic_.load(std::memory_order_relaxed);
-                            if (count > 0) {
-                                ready_count_aic_.fetch_sub(1, std::memory_order_release);
-                                int task_id = ready_queue_aic_[count - 1];
-                                Task* task = runtime.get_task(task_id);
-
-                                DEV_INFO("Thread %d: Dispatching AIC task %d to core %d", thread_idx, task_id, core_id);
-
-                                h->task = reinterpret_cast<uint64_t>(task);
-                                h->task_status = 1;  // Mark as busy
+        // Load balancing: Skip dispatch if all my mailboxes are full
+        if (cur_thread_tasks_in_flight < core_num * mailbox_depth_ && core_num > 0) {
+            // Phase 2: Post ready tasks to the mailboxes of my cores, one
+            // slot depth at a time so idle cores are fed before busy cores
+            // get a task staged; only cores in free_mask are visited. Tasks
+            // held for a core's block go first. Only idle cores steal from
+            // other threads; staging uses this thread's own queues.
+            bool queue_empty[2] = {false, false};
+            for (int fill = 0; fill < mailbox_depth_; fill++) {
+                for (int w = 0; w < mask_words; w++) {
+                    uint64_t candidates = free_mask[w];
+                    while (candidates != 0) {
+                        int i = w * 64 + __builtin_ctzll(candidates);
+                        candidates &= candidates - 1;
+                        int core_id = cur_thread_cores[i];
+                        Handshake* h = &hank[core_id];
+                        int queue_idx = h->core_type == 0 ? 0 : 1;
+                        uint32_t occupancy = core_occupancy(core_id);
+
+                        if (occupancy == static_cast<uint32_t>(mailbox_depth_)) {
+                            free_mask[w] &= ~(1ULL << (i % 64));  // Filled by a MIX gang post
+                            continue;
+                        }
+                        if (occupancy != static_cast<uint32_t>(fill)) {
+                            continue;
+                        }
+
+                        // Dispatch a held task, else from matching queue based
+                        // on core type. A MIX task the AIC takes waits for the
+                        // block's AIVs, which meanwhile take nothing new.
+                        int block = core_block_[core_id];
+                        if (block_gang_[block] < 0) {
+                            bool stolen = false;
+                            bool same_core = false;
+                            int task_id = locality ? take_held(core_id, queue_idx, &same_core) : -1;
+                            bool held = task_id >= 0;
+                            if (!held) {
+                                if (queue_empty[queue_idx]) {
+                                    continue;
+                                }
+                                task_id = pop_ready(thread_idx, queue_idx, fill == 0, &stolen);
+                                if (task_id < 0) {
+                                    queue_empty[queue_idx] = true;
+                                    continue;
+                                }
+                            }
+                            bool mix = runtime.sched_at(task_id)->core_type == static_cast<int>(CoreType::MIX);
+
+                            DEV_INFO("Thread %d: Dispatching %s%s task %d to core %d (slot %d)", thread_idx,
+                                stolen ? "stolen " : (held ? (same_core ? "local " : "block-local ") : ""),
+                                mix ? "MIX" : (queue_idx == 0 ? "AIC" : "AIV"), task_id, core_id, fill);
+                            if (stolen) {
+                                cur_thread_stolen++;
+                            } else if (held) {
+                                if (same_core) {
+                                    cur_thread_same_core++;
+                                } else {
+                                    cur_thread_same_block++;
+                                }
+                            }
+                            made_progress = true;
+
+                            if (mix) {
+                                block_gang_[block] = task_id;
+                            } else {
+                                post_task(hank, core_id, task_id, runtime.task_at(task_id));
                                 cur_thread_tasks_in_flight++;
-                                made_progress = true;
                             }
                         }
-                    } else if (h->core_type == 1) {  // AIV core
-                        if (ready_count_aiv_.load(std::memory_order_acquire) > 0) {
-                            std::lock_guard<std::mutex> lock(ready_queue_aiv_mutex_);
-                            int count = ready_count_aiv_.load(std::memory_order_relaxed);
-                            if (count > 0) {
-                                ready_count_aiv_.fetch_sub(1, std::memory_order_release);
-                                int task_id = ready_queue_aiv_[count - 1];
-                                Task* task = runtime.get_task(task_id);
-
-                                DEV_INFO("Thread %d: Dispatching AIV task %d to core %d", thread_idx, task_id, core_id);
-
-                                h->task = reinterpret_cast<uint64_t>(task);
-                                h->task_status = 1;  // Mark as busy
-                                cur_thread_tasks_in_flight++;
-                                made_progress = true;
+                        if (block_gang_[block] >= 0) {
+                            if (queue_idx != 0 || !post_gang(runtime, hank, block)) {
+                                continue;
                             }
+                            cur_thread_tasks_in_flight += RUNTIME_MIX_ROLES;
+                            cur_thread_gangs++;
+                            made_progress = true;
+                        }
+                        if (core_occupancy(core_id) == static_cast<uint32_t>(mailbox_depth_)) {
+                            free_mask[w] &= ~(1ULL << (i % 64));
                         }
                     }
                 }
             }
         }
 
+        // Held tasks whose block stayed busy for locality_wait_ rounds fall
+        // back to the ready queue (and to any idle core)
+        if (locality && !release_held(thread_idx, round)) {
+            diagnose_stuck_state(runtime, thread_idx, cur_thread_cores, core_num, hank);
+            return -1;
+        }
+
         // Timeout detection: track idle iterations when no progress
         if (!made_progress) {
-            idle_iterations++;
-            if (idle_iterations % WARN_INTERVAL == 0) {
-                int current = completed_tasks_.load(std::memory_order_acquire);
+            bool timed_out = idle_wait(runtime, ++idle_rounds, &armed);
+            if (cur_thread_gangs > 0 && round % GANG_IDLE_STRIDE != 0) {
+                continue;
+            }
+            int idle_step = timed_out ? IDLE_BLOCK_ITERATIONS : 1;
+            idle_iterations += idle_step;
+            if (idle_iterations % WARN_INTERVAL < idle_step) {
+                int current = completed_count();
                 DEV_WARN("Thread %d: %d idle iterations, progress %d/%d tasks",
                         thread_idx, idle_iterations, current, task_count);
             }
@@ -392,10 +1456,22 @@ int AicpuExecutor::resolve_and_dispatch(Runtime& runtime, int thread_idx, const
             }
         } else {
             idle_iterations = 0;
+            idle_rounds = 0;
+            armed = 0;
+            // Peers blocked idle may now steal, take a block or see the
+            // launch complete
+            if (thread_num_ > 1) {
+                aicpu_wake(&runtime.sched_wake);
+            }
         }
     }
 
-    DEV_INFO("Thread %d: Execution complete, completed %d tasks", thread_idx, cur_thread_completed);
+    DEV_INFO("Thread %d: Execution complete, completed %d tasks (%d stolen, %d chained)", thread_idx,
+        cur_thread_completed, cur_thread_stolen, cur_thread_chained);
+    if (locality) {
+        DEV_INFO("Thread %d: Locality placement: %d tasks on the producing core, %d on its block", thread_idx,
+            cur_thread_same_core, cur_thread_same_block);
+    }
     return cur_thread_completed;
 }
 
@@ -404,7 +1480,7 @@ int AicpuExecutor::run(Runtime* runtime) {
 
     DEV_INFO("Thread %d: Start", thread_idx);
 
-    const int* cur_thread_cores = core_assignments_[thread_idx];
+    const int* cur_thread_cores = thread_slots_[thread_idx].cores;
 
     auto rc = hank_aicore(runtime, thread_idx, cur_thread_cores);
     if (rc != 0) {
@@ -412,9 +1488,12 @@ int AicpuExecutor::run(Runtime* runtime) {
     }
 
     DEV_INFO("Thread %d: Runtime has %d tasks", thread_idx, runtime->get_task_count());
-    int completed = resolve_and_dispatch(*runtime, thread_idx, cur_thread_cores, thread_cores_num_);
+    int completed = resolve_and_dispatch(*runtime, thread_idx, cur_thread_cores);
     DEV_INFO("Thread %d: Executed %d tasks from runtime", thread_idx, completed);
 
+    // A timed out or stuck thread still releases its cores and counts as
+    // finished, so the launch ends and the executor is reset; it reports
+    // the failure once that is done
     rc = shutdown_aicore(runtime, thread_idx, cur_thread_cores);
     if (rc != 0) {
         return rc;
@@ -425,18 +1504,19 @@ int AicpuExecutor::run(Runtime* runtime) {
     // Check if this is the last thread to finish
     int prev_finished = finished_count_.fetch_add(1, std::memory_order_acq_rel);
     if (prev_finished + 1 == thread_num_) {
+        publish_samples(runtime);
         finished_.store(true, std::memory_order_release);
         DEV_INFO("Thread %d: Last thread, marking executor finished", thread_idx);
     }
 
-    return 0;
+    return completed < 0 ? -1 : 0;
 }
 
 void AicpuExecutor::deinit() {
     // Cleanup runtime execution state
-    ready_count_aic_.store(0, std::memory_order_release);
-    ready_count_aiv_.store(0, std::memory_order_release);
-    completed_tasks_.store(0, std::memory_order_release);
+    for (int t = 0; t < thread_num_ && t < thread_capacity_; t++) {
+        completed_shards_[t].count.store(0, std::memory_order_release);
+    }
     total_tasks_.store(0, std::memory_order_release);
     finished_count_.store(0, std::memory_order_release);
 
@@ -456,14 +1536,20 @@ void AicpuExecutor::diagnose_stuck_state(Runtime& runtime, int thread_idx,
                                          Handshake* hank) {
     DEV_ERROR("========== DIAGNOSTIC REPORT: Thread %d ==========", thread_idx);
 
-    int completed = completed_tasks_.load(std::memory_order_acquire);
+    int completed = completed_count();
     int total = total_tasks_.load(std::memory_order_acquire);
     DEV_ERROR("Progress: %d/%d tasks (%.1f%%)",
              completed, total, total > 0 ? completed * 100.0 / total : 0.0);
 
-    int aic_ready = ready_count_aic_.load(std::memory_order_acquire);
-    int aiv_ready = ready_count_aiv_.load(std::memory_order_acquire);
-    DEV_ERROR("Ready Queues: AIC=%d, AIV=%d", aic_ready, aiv_ready);
+    int aic_ready = ready_count(0);
+    int aiv_ready = ready_count(1);
+    int held = held_count(thread_idx);
+    DEV_ERROR("Ready Queues: AIC=%d, AIV=%d, held for blocks=%d", aic_ready, aiv_ready, held);
+    if (resolve_on_aicore_) {
+        DEV_ERROR("Resolved queue: %d published by AICores, %d placed",
+                 runtime.resolved_tail.load(std::memory_order_acquire),
+                 runtime.resolved_head.load(std::memory_order_acquire));
+    }
 
     int busy_cores = 0;
     int idle_cores = 0;
@@ -472,22 +1558,32 @@ void AicpuExecutor::diagnose_stuck_state(Runtime& runtime, int thread_idx,
     DEV_ERROR("Core Status:");
     for (int i = 0; i < core_num; i++) {
         int core_id = cur_thread_cores[i];
+        if (core_id < 0) {
+            continue;  // Handed to another thread
+        }
         Handshake* h = &hank[core_id];
 
         const char* core_type_str = (h->core_type == 0) ? "AIC" : "AIV";
+        uint32_t posted = core_posted_[core_id];
+        uint32_t done = h->done_count;
 
-        if (h->task != 0) {
-            Task* task = reinterpret_cast<Task*>(h->task);
+        if (static_cast<int32_t>(done - core_executed_[core_id]) < 0) {
+            anomaly_cores++;
+            DEV_ERROR("  Core %d [%s, ANOMALY]: done=%u behind %u completions processed", core_id, core_type_str,
+                     done, core_executed_[core_id]);
+        } else if (posted != core_completed_[core_id] || core_chain_[core_id] >= 0) {
+            int task_id = core_chain_[core_id] >= 0
+                              ? core_chain_[core_id]
+                              : core_task_ids_[core_id][core_completed_[core_id] % RUNTIME_MAX_MAILBOX_DEPTH];
+            Task* task = runtime.task_at(task_id);
+            TaskSched* sched = runtime.sched_at(task_id);
             busy_cores++;
 
-            DEV_ERROR("  Core %d [%s, BUSY]: task_id=%d, func_id=%d, fanin=%d, fanout=%d",
+            DEV_ERROR("  Core %d [%s, BUSY]: task_id=%d, func_id=%d, fanin=%d, fanout=%d, in_flight=%u",
                      core_id, core_type_str,
-                     task->task_id, task->func_id,
-                     task->fanin.load(std::memory_order_acquire),
-                     task->fanout_count);
-        } else if (h->task_status != 0) {
-            anomaly_cores++;
-            DEV_ERROR("  Core %d [%s, ANOMALY]: status=BUSY but task=NULL", core_id, core_type_str);
+                     task_id, task->func_id,
+                     sched->fanin.load(std::memory_order_acquire),
+                     sched->fanout_count, posted - core_completed_[core_id]);
         } else {
             idle_cores++;
         }
@@ -496,15 +1592,14 @@ void AicpuExecutor::diagnose_stuck_state(Runtime& runtime, int thread_idx,
     DEV_ERROR("Summary: %d busy, %d idle, %d anomaly", busy_cores, idle_cores, anomaly_cores);
 
     // Diagnose deadlock vs livelock
-    if (busy_cores == 0 && aic_ready == 0 && aiv_ready == 0 && completed < total) {
+    if (busy_cores == 0 && aic_ready == 0 && aiv_ready == 0 && held == 0 && completed < total) {
         DEV_ERROR("*** DEADLOCK DETECTED ***");
         DEV_ERROR("All cores idle, no ready tasks, but %d tasks incomplete", total - completed);
 
         DEV_ERROR("Tasks with fanin > 0:");
         int stuck_count = 0;
         for (int tid = 0; tid < total && stuck_count < 10; tid++) {
-            Task* t = runtime.get_task(tid);
-            int fanin = t->fanin.load(std::memory_order_acquire);
+            int fanin = runtime.sched_at(tid)->fanin.load(std::memory_order_acquire);
             if (fanin > 0) {
                 DEV_ERROR("  Task %d: fanin=%d (waiting for dependencies)", tid, fanin);
                 stuck_count++;
@@ -528,7 +1623,8 @@ void AicpuExecutor::diagnose_stuck_state(Runtime& runtime, int thread_idx,
  *
  * This is called by DynTileFwkBackendKernelServer in kernel.cpp.
  * Orchestrates the complete task runtime execution:
- * 1. Initialize executor (thread-safe, first thread only)
+ * 1. Initialize the executor of the runtime's partition (thread-safe,
+ *    first thread only)
  * 2. Wait for initialization to complete
  * 3. Execute tasks on managed cores
  * 4. Cleanup when last thread finishes
@@ -536,7 +1632,8 @@ void AicpuExecutor::diagnose_stuck_state(Runtime& runtime, int thread_idx,
  * @param runtime Pointer to Runtime structure containing:
  *                - workers[]: handshake buffers for AICPU-AICore communication
  *                - block_dim, sche_cpu_num: execution parameters
- *                - tasks[]: task runtime to execute
+ *                - partition: executor instance to schedule on
+ *                - task_chunks[]: task runtime to execute
  * @return 0 on success, non-zero on error
  */
 extern "C" int aicpu_execute(Runtime* runtime) {
@@ -545,29 +1642,37 @@ extern "C" int aicpu_execute(Runtime* runtime) {
         return -1;
     }
 
-    DEV_INFO("%s", "aicpu_execute: Starting AICPU kernel execution");
+    if (runtime->partition < 0 || runtime->partition >= RUNTIME_MAX_PARTITIONS) {
+        DEV_ERROR("Invalid partition: %d (must be 0..%d)", runtime->partition, RUNTIME_MAX_PARTITIONS - 1);
+        return -1;
+    }
+    AicpuExecutor& executor = g_aicpu_executors[runtime->partition];
+
+    DEV_INFO("aicpu_execute: Starting AICPU kernel execution on partition %d", runtime->partition);
 
-    g_aicpu_executor.init(runtime);
+    executor.init(runtime);
 
-    while (!g_aicpu_executor.init_done_.load(std::memory_order_acquire)) {
-        if (g_aicpu_executor.init_failed_.load(std::memory_order_acquire)) {
+    while (!executor.init_done_.load(std::memory_order_acquire)) {
+        if (executor.init_failed_.load(std::memory_order_acquire)) {
             DEV_ERROR("%s", "aicpu_execute: Initialization failed, aborting execution");
             return -1;
         }
     }
 
-    int rc = g_aicpu_executor.run(runtime);
+    int rc = executor.run(runtime);
+
+    // Last thread cleans up, also after a failed run so the next launch
+    // on this partition starts from a fresh executor
+    if (executor.finished_.load(std::memory_order_acquire)) {
+        DEV_INFO("aicpu_execute: Last thread finished, cleaning up");
+        executor.deinit();
+    }
+
     if (rc != 0) {
         DEV_ERROR("aicpu_execute: Thread execution failed with rc=%d", rc);
         return rc;
     }
 
-    // Last thread cleans up
-    if (g_aicpu_executor.finished_.load(std::memory_order_acquire)) {
-        DEV_INFO("aicpu_execute: Last thread finished, cleaning up");
-        g_aicpu_executor.deinit();
-    }
-
     DEV_INFO("%s", "aicpu_execute: Kernel execution completed successfully");
     return 0;
 }
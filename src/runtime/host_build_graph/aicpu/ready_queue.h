@@ -0,0 +1,132 @@
+/**
+ * Ready Queue - Bounded Lock-Free MPMC Queue of Ready Tasks
+ *
+ * One ReadyQueue holds the ready tasks of one core type and is shared by all
+ * AICPU scheduler threads without locks. Tasks are grouped into
+ * READY_LEVELS priority levels (quantized upward rank); dequeue takes the
+ * oldest task of the highest non-empty level, so the critical path is
+ * still dispatched first.
+ *
+ * Each level is a slice of one slot array sized in reset() to exactly the
+ * number of tasks that map to it. Every task enters its queue at most once
+ * per launch, so a level never wraps: producers reserve slots with a single
+ * fetch_add on the level's tail (a whole batch at once) and publish each
+ * slot by storing the launch generation into it; consumers claim the slot
+ * at head with a CAS once it is published. Because slots are never reused
+ * within a launch there is no ABA, and stale slots from earlier launches
+ * are told apart by their generation instead of being cleared.
+ */
+
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+constexpr int READY_LEVELS = 32;  // Priority levels per queue
+
+struct ReadySlot {
+    std::atomic<int> gen;  // Launch generation that published this slot
+    int task_id;
+};
+
+struct ReadyQueue {
+    struct Level {
+        alignas(64) std::atomic<int> head{0};  // Next slot to dequeue (consumers)
+        alignas(64) std::atomic<int> tail{0};  // Next slot to reserve (producers)
+        int base{0};                           // First slot of this level
+        int capacity{0};                       // Tasks that map to this level
+    };
+
+    Level levels[READY_LEVELS];
+    std::unique_ptr<ReadySlot[]> slots;
+    int slot_capacity{0};
+    int gen{0};
+
+    /**
+     * Prepare for a launch (single-threaded, before any push or pop)
+     *
+     * @param level_counts  Number of tasks per level (READY_LEVELS entries)
+     * @return false if the slot array could not be allocated
+     */
+    bool reset(const int* level_counts) {
+        int total = 0;
+        for (int l = 0; l < READY_LEVELS; l++) {
+            levels[l].base = total;
+            levels[l].capacity = level_counts[l];
+            levels[l].head.store(0, std::memory_order_relaxed);
+            levels[l].tail.store(0, std::memory_order_relaxed);
+            total += level_counts[l];
+        }
+        if (total > slot_capacity) {
+            // Value-initialized, so every generation starts at 0
+            slots.reset(new (std::nothrow) ReadySlot[total]());
+            slot_capacity = slots ? total : 0;
+            if (!slots) {
+                return false;
+            }
+        }
+        gen++;
+        return true;
+    }
+
+    /**
+     * Publish n tasks of one level with a single reservation
+     *
+     * @return false if the level would overflow (a task pushed twice)
+     */
+    bool push_bulk(int level, const int* task_ids, int n) {
+        Level& lv = levels[level];
+        int pos = lv.tail.fetch_add(n, std::memory_order_relaxed);
+        if (pos + n > lv.capacity) {
+            return false;
+        }
+        for (int k = 0; k < n; k++) {
+            ReadySlot& slot = slots[lv.base + pos + k];
+            slot.task_id = task_ids[k];
+            slot.gen.store(gen, std::memory_order_release);
+        }
+        return true;
+    }
+
+    /**
+     * Dequeue the oldest task of the highest non-empty level
+     *
+     * A slot that is reserved but not yet published reads as empty; the
+     * caller simply polls again.
+     *
+     * @return Task ID, or -1 if nothing is ready
+     */
+    int pop() {
+        for (int l = READY_LEVELS - 1; l >= 0; l--) {
+            Level& lv = levels[l];
+            int h = lv.head.load(std::memory_order_relaxed);
+            while (h < lv.tail.load(std::memory_order_acquire)) {
+                const ReadySlot& slot = slots[lv.base + h];
+                if (slot.gen.load(std::memory_order_acquire) != gen) {
+                    break;  // Producer still publishing
+                }
+                int task_id = slot.task_id;
+                if (lv.head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return task_id;
+                }
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Approximate number of queued tasks (for diagnostics)
+     */
+    int size() const {
+        int total = 0;
+        for (int l = 0; l < READY_LEVELS; l++) {
+            int queued = levels[l].tail.load(std::memory_order_acquire) - levels[l].head.load(std::memory_order_acquire);
+            total += queued > 0 ? queued : 0;
+        }
+        return total;
+    }
+};
+
+#endif  // READY_QUEUE_H
@@ -0,0 +1,169 @@
+/**
+ * Scheduling Policies - Task and Core Selection for the AICPU Executor
+ *
+ * A policy decides which ready task a core gets next and whether ready
+ * successors are held for the core that produced their input. Task order is
+ * expressed as a per-task priority computed once per launch in prepare();
+ * the executor maps priorities onto the ready queue's levels, so the
+ * lock-free queues and the dispatch loop are shared by every policy and
+ * only the table differs. Core selection is either "any idle core" or
+ * locality (see AicpuExecutor::hold_for_block()).
+ *
+ * Policies, selected by Runtime::sched_policy (RUNTIME_SCHED_*):
+ * - FIFO: arrival order
+ * - LIFO: most recently enabled first. The ready queue is FIFO within a
+ *   level, so this is realized as deepest task first (longest path from a
+ *   source), which gives the depth-first order a LIFO stack produces
+ * - Critical path: highest upward rank first (Runtime::task_ranks)
+ * - Shortest job first: lowest estimated cost first. A task's cost is its
+ *   rank minus the highest rank among its successors, i.e. the cost that
+ *   finalize_graph() took from set_func_cost()
+ * - Locality: arrival order, successors held for the producing block
+ */
+
+#ifndef SCHED_POLICY_H
+#define SCHED_POLICY_H
+
+#include <vector>
+
+#include "runtime.h"
+
+class SchedPolicy {
+public:
+    virtual ~SchedPolicy() {}
+
+    virtual const char* name() const = 0;
+
+    /**
+     * Compute the task priorities for a launch (single-threaded, before any
+     * task is queued)
+     *
+     * @return false if the policy cannot schedule this graph
+     */
+    virtual bool prepare(const Runtime& runtime) = 0;
+
+    // Hold ready successors for the block of the core that produced them
+    virtual bool prefer_locality() const { return false; }
+
+    // Priority of a task in [0, max_priority()]; higher is dispatched first
+    int priority(int task_id) const { return priorities_ != nullptr ? priorities_[task_id] : 0; }
+    int max_priority() const { return max_priority_; }
+
+protected:
+    // Use table (or no table: every task priority 0) as this launch's priorities
+    void set_priorities(const int* table, int task_count) {
+        priorities_ = table;
+        max_priority_ = 0;
+        for (int i = 0; table != nullptr && i < task_count; i++) {
+            if (table[i] > max_priority_) {
+                max_priority_ = table[i];
+            }
+        }
+    }
+
+    const int* priorities_{nullptr};
+    int max_priority_{0};
+};
+
+class FifoPolicy : public SchedPolicy {
+public:
+    const char* name() const override { return "FIFO"; }
+    bool prepare(const Runtime& runtime) override {
+        set_priorities(nullptr, runtime.get_task_count());
+        return true;
+    }
+};
+
+class LifoPolicy : public SchedPolicy {
+public:
+    const char* name() const override { return "LIFO"; }
+    bool prepare(const Runtime& runtime) override {
+        int task_count = runtime.get_task_count();
+        if (runtime.fanin_snapshot == nullptr) {
+            return false;
+        }
+        depth_.assign(task_count, 0);
+        remaining_.assign(runtime.fanin_snapshot, runtime.fanin_snapshot + task_count);
+        order_.clear();
+        for (int i = 0; i < task_count; i++) {
+            if (remaining_[i] == 0) {
+                order_.push_back(i);
+            }
+        }
+        // Kahn's algorithm; order_ doubles as the work queue
+        for (size_t k = 0; k < order_.size(); k++) {
+            int task_id = order_[k];
+            const TaskSched* sched = runtime.sched_at(task_id);
+            const int* fanout = runtime.get_fanout(sched);
+            for (int j = 0; j < sched->fanout_count; j++) {
+                int succ = fanout[j];
+                if (depth_[succ] < depth_[task_id] + 1) {
+                    depth_[succ] = depth_[task_id] + 1;
+                }
+                if (--remaining_[succ] == 0) {
+                    order_.push_back(succ);
+                }
+            }
+        }
+        set_priorities(depth_.data(), task_count);
+        return static_cast<int>(order_.size()) == task_count;
+    }
+
+private:
+    std::vector<int> depth_;
+    std::vector<int> remaining_;
+    std::vector<int> order_;
+};
+
+class CriticalPathPolicy : public SchedPolicy {
+public:
+    const char* name() const override { return "critical-path"; }
+    bool prepare(const Runtime& runtime) override {
+        set_priorities(runtime.task_ranks, runtime.get_task_count());
+        return true;
+    }
+};
+
+class ShortestJobPolicy : public SchedPolicy {
+public:
+    const char* name() const override { return "shortest-job"; }
+    bool prepare(const Runtime& runtime) override {
+        int task_count = runtime.get_task_count();
+        if (runtime.task_ranks == nullptr) {
+            set_priorities(nullptr, task_count);
+            return true;
+        }
+        cost_.resize(task_count);
+        int max_cost = 0;
+        for (int i = 0; i < task_count; i++) {
+            const TaskSched* sched = runtime.sched_at(i);
+            const int* fanout = runtime.get_fanout(sched);
+            int tail = 0;
+            for (int j = 0; j < sched->fanout_count; j++) {
+                if (runtime.task_ranks[fanout[j]] > tail) {
+                    tail = runtime.task_ranks[fanout[j]];
+                }
+            }
+            cost_[i] = runtime.task_ranks[i] - tail;
+            if (cost_[i] > max_cost) {
+                max_cost = cost_[i];
+            }
+        }
+        for (int i = 0; i < task_count; i++) {
+            cost_[i] = max_cost - cost_[i];
+        }
+        set_priorities(cost_.data(), task_count);
+        return true;
+    }
+
+private:
+    std::vector<int> cost_;
+};
+
+class LocalityPolicy : public FifoPolicy {
+public:
+    const char* name() const override { return "locality"; }
+    bool prefer_locality() const override { return true; }
+};
+
+#endif  // SCHED_POLICY_H
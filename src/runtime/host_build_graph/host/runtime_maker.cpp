@@ -7,6 +7,7 @@
  * init_runtime_impl:
  *   - Calls orchestration function to build task graph
  *   - Orchestration is responsible for device memory management
+ *   - Packs the successor lists (Runtime::finalize_graph)
  *
  * validate_runtime_impl (finalize_runtime_impl):
  *   - Copies recorded tensors back from device to host
@@ -128,6 +129,15 @@ int init_runtime_impl(Runtime *runtime,
         return rc;
     }
 
+    // Pack successor lists into the contiguous CSR edge array
+    rc = runtime->finalize_graph();
+    if (rc != 0) {
+        std::cerr << "Error: Failed to finalize task graph\n";
+        runtime->clear_tensor_pairs();
+        dlclose(handle);
+        return rc;
+    }
+
     std::cout << "\nRuntime initialized. Ready for execution from Python.\n";
 
     // Note: We intentionally leak the dlopen handle to keep the SO loaded
@@ -7,6 +7,9 @@
 
 #include "runtime.h"
 
+#include <math.h>    // for pow, sqrt
+#include <stdlib.h>  // for malloc, realloc, free
+
 // =============================================================================
 // Constructor
 // =============================================================================
@@ -15,26 +18,106 @@ Runtime::Runtime() {
     // NOTE: host_api is initialized in InitRuntime() (host-only code)
     // because the CApi functions don't exist when compiled for device.
 
-    // Initialize task array (cannot use memset with atomic members)
-    for (int i = 0; i < RUNTIME_MAX_TASKS; i++) {
-        tasks[i].task_id = 0;
-        tasks[i].func_id = 0;
-        tasks[i].num_args = 0;
-        tasks[i].function_bin_addr = 0;
-        tasks[i].core_type = 0;
-        tasks[i].fanin = 0;
-        tasks[i].fanout_count = 0;
-        tasks[i].start_time = 0;
-        tasks[i].end_time = 0;
-        memset(tasks[i].args, 0, sizeof(tasks[i].args));
-        memset(tasks[i].fanout, 0, sizeof(tasks[i].fanout));
+    // Task chunks are allocated by add_task() on demand
+    for (int i = 0; i < RUNTIME_MAX_TASK_CHUNKS; i++) {
+        task_chunks[i] = nullptr;
     }
+    task_chunk_count = 0;
     next_task_id = 0;
-    initial_ready_count = 0;
+    finalized_task_count = 0;
+    workers = nullptr;
     worker_count = 0;
+    worker_capacity = 0;
     block_dim = 0;
     sche_cpu_num = 1;
+    sched_group_size = 0;
+    partition = 0;
+    mailbox_depth = 1;
+    resolve_on_aicore = 0;
+    chain_successors = 0;
+    rebalance_cores = 0;
+    idle_wait = RUNTIME_WAIT_YIELD;
+    idle_spin = 64;
+    idle_yield = 64;
+    sched_wake = 0;
+    chain_next = nullptr;
+    resolved_ids = nullptr;
+    resolved_tail.store(0, std::memory_order_relaxed);
+    resolved_head.store(0, std::memory_order_relaxed);
+    doorbells = nullptr;
+    doorbell_count = 0;
+    doorbell_capacity = 0;
+    fanout_edges = nullptr;
+    fanout_edge_count = 0;
+    fanin_snapshot = nullptr;
+    task_ranks = nullptr;
+    schedule_by_rank = 1;
+    placement_policy = 0;
+    locality_wait = 64;
+    sched_policy = RUNTIME_SCHED_GRAPH;
     tensor_pair_count = 0;
+    pending_edges = nullptr;
+    pending_edge_count = 0;
+    pending_edge_capacity = 0;
+    params = nullptr;
+    param_count = 0;
+    param_capacity = 0;
+    param_slots = nullptr;
+    param_slot_count = 0;
+    param_slot_capacity = 0;
+    region_segs = nullptr;
+    region_seg_count = 0;
+    region_seg_capacity = 0;
+    reader_nodes = nullptr;
+    reader_node_count = 0;
+    reader_node_capacity = 0;
+    dep_marks = nullptr;
+    dep_declared = nullptr;
+    dep_task_capacity = 0;
+    edge_report = false;
+    func_costs = nullptr;
+    func_cost_count = 0;
+    memset(cost_model, 0, sizeof(cost_model));
+    memset(func_samples, 0, sizeof(func_samples));
+    memset(rank_basis, 0, sizeof(rank_basis));
+}
+
+Runtime::~Runtime() {
+    for (int i = 0; i < task_chunk_count; i++) {
+        free(task_chunks[i]);
+        task_chunks[i] = nullptr;
+    }
+    task_chunk_count = 0;
+    free(workers);
+    free(doorbells);
+    free(fanout_edges);
+    free(fanin_snapshot);
+    free(task_ranks);
+    free(resolved_ids);
+    free(chain_next);
+    free(pending_edges);
+    free(params);
+    free(param_slots);
+    free(region_segs);
+    free(reader_nodes);
+    free(dep_marks);
+    free(dep_declared);
+    free(func_costs);
+    workers = nullptr;
+    doorbells = nullptr;
+    fanout_edges = nullptr;
+    fanin_snapshot = nullptr;
+    task_ranks = nullptr;
+    resolved_ids = nullptr;
+    chain_next = nullptr;
+    pending_edges = nullptr;
+    params = nullptr;
+    param_slots = nullptr;
+    region_segs = nullptr;
+    reader_nodes = nullptr;
+    dep_marks = nullptr;
+    dep_declared = nullptr;
+    func_costs = nullptr;
 }
 
 // =============================================================================
@@ -53,22 +136,43 @@ int Runtime::add_task(uint64_t* args, int num_args, int func_id, int core_type)
         return -1;
     }
 
+    if (core_type < static_cast<int>(CoreType::AIC) || core_type > static_cast<int>(CoreType::MIX)) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid core_type %d\n", core_type);
+        return -1;
+    }
+
+    // Start a new chunk when the current one is full. Existing chunks are
+    // never reallocated, so Task* pointers stay stable.
+    if ((next_task_id >> RUNTIME_TASK_CHUNK_SHIFT) >= task_chunk_count) {
+        TaskChunk* chunk = static_cast<TaskChunk*>(malloc(sizeof(TaskChunk)));
+        if (chunk == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory allocating task chunk %d\n", task_chunk_count);
+            return -1;
+        }
+        task_chunks[task_chunk_count++] = chunk;
+    }
+
     // Allocate task
     int task_id = next_task_id++;
-    Task* task = &tasks[task_id];
+    Task* task = task_at(task_id);
+    TaskSched* sched = sched_at(task_id);
 
-    // Initialize task fields
+    // Initialize task fields (chunk memory is uninitialized)
     task->task_id = task_id;
     task->func_id = func_id;
     task->num_args = num_args;
+    memset(task->args, 0, sizeof(task->args));
     if (args && num_args > 0) {
         memcpy(task->args, args, num_args * sizeof(uint64_t));
     }
     task->function_bin_addr = 0;    // Will be set by host before copying to device
-    task->core_type = core_type;    // Set core type (0=AIC, 1=AIV)
-    task->fanin = 0;
-    task->fanout_count = 0;
-    memset(task->fanout, 0, sizeof(task->fanout));
+    task->start_time = 0;
+    task->end_time = 0;
+
+    sched->fanin = 0;
+    sched->fanout_offset = 0;
+    sched->fanout_count = 0;
+    sched->core_type = core_type;  // Set core type (0=AIC, 1=AIV, 2=MIX)
 
     return task_id;
 }
@@ -85,17 +189,745 @@ void Runtime::add_successor(int from_task, int to_task) {
         return;
     }
 
-    Task* from = &tasks[from_task];
-    Task* to = &tasks[to_task];
+    record_edge(from_task, to_task, 0);
+}
 
-    // Add to_task to from_task's fanout
-    if (from->fanout_count >= RUNTIME_MAX_FANOUT) {
-        fprintf(stderr, "[Runtime] ERROR: Fanout overflow for task %d (max=%d)\n", from_task, RUNTIME_MAX_FANOUT);
-        return;
+bool Runtime::record_edge(int from_task, int to_task, int inferred) {
+    // Grow the pending edge list geometrically
+    if (pending_edge_count >= pending_edge_capacity) {
+        int new_capacity = pending_edge_capacity > 0 ? pending_edge_capacity * 2 : 64;
+        RuntimeEdge* grown =
+            static_cast<RuntimeEdge*>(realloc(pending_edges, new_capacity * sizeof(RuntimeEdge)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory recording edge %d -> %d\n", from_task, to_task);
+            return false;
+        }
+        pending_edges = grown;
+        pending_edge_capacity = new_capacity;
     }
 
-    from->fanout[from->fanout_count++] = to_task;
+    TaskSched* from = sched_at(from_task);
+    TaskSched* to = sched_at(to_task);
+
+    pending_edges[pending_edge_count].from_task = from_task;
+    pending_edges[pending_edge_count].to_task = to_task;
+    pending_edges[pending_edge_count].inferred = inferred;
+    pending_edge_count++;
+
+    from->fanout_count++;
     to->fanin++;
+    return true;
+}
+
+int Runtime::finalize_graph() {
+    // Already packed and no tasks or edges added since
+    if (fanout_edges != nullptr && fanout_edge_count == pending_edge_count &&
+        finalized_task_count == next_task_id) {
+        return 0;
+    }
+
+    // Always keep valid (possibly empty) arrays so get_fanout() is safe
+    int* edges = static_cast<int*>(malloc((pending_edge_count > 0 ? pending_edge_count : 1) * sizeof(int)));
+    int* offsets = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    int* snapshot = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    int* ranks = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    int* chains = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    std::atomic<int>* resolved =
+        static_cast<std::atomic<int>*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(std::atomic<int>)));
+    if (edges == nullptr || offsets == nullptr || snapshot == nullptr || ranks == nullptr || chains == nullptr ||
+        resolved == nullptr) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory packing %d edges\n", pending_edge_count);
+        free(edges);
+        free(offsets);
+        free(snapshot);
+        free(ranks);
+        free(chains);
+        free(resolved);
+        return -1;
+    }
+    memset(static_cast<void*>(resolved), 0, (next_task_id > 0 ? next_task_id : 1) * sizeof(std::atomic<int>));
+    free(resolved_ids);
+    resolved_ids = resolved;
+
+    pack_edges(edges, offsets);
+    for (int i = 0; i < next_task_id; i++) {
+        TaskSched* sched = sched_at(i);
+        sched->fanout_offset = offsets[i];
+        snapshot[i] = sched->fanin.load(std::memory_order_relaxed);
+    }
+    free(offsets);
+
+    free(fanout_edges);
+    fanout_edges = edges;
+    fanout_edge_count = pending_edge_count;
+    free(fanin_snapshot);
+    fanin_snapshot = snapshot;
+    finalized_task_count = next_task_id;
+
+    if (!compute_ranks(ranks)) {
+        // Not finalized: a later call must pack again instead of taking the
+        // early return with stale task_ranks and chain_next
+        finalized_task_count = -1;
+        free(ranks);
+        free(chains);
+        return -1;
+    }
+    free(task_ranks);
+    task_ranks = ranks;
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        rank_basis[f] = rank_cost(f);
+    }
+
+    // Chain successor: first same-type successor with no other predecessor;
+    // a MIX gang needs its whole block, so MIX tasks are left out
+    for (int i = 0; i < next_task_id; i++) {
+        const TaskSched* sched = sched_at(i);
+        const int* fanout = get_fanout(sched);
+        chains[i] = -1;
+        for (int j = 0; j < sched->fanout_count && sched->core_type != static_cast<int>(CoreType::MIX); j++) {
+            int succ = fanout[j];
+            if (fanin_snapshot[succ] == 1 && sched_at(succ)->core_type == sched->core_type) {
+                chains[i] = succ;
+                break;
+            }
+        }
+    }
+    free(chain_next);
+    chain_next = chains;
+
+    if (edge_report) {
+        report_unneeded_edges();
+    }
+    return 0;
+}
+
+int Runtime::set_func_cost(int func_id, int cost) {
+    if (func_id < 0 || cost < 1) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid cost %d for func_id %d\n", cost, func_id);
+        return -1;
+    }
+    if (func_id >= func_cost_count) {
+        int new_count = func_id + 1;
+        int* grown = static_cast<int*>(realloc(func_costs, new_count * sizeof(int)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory setting cost for func_id %d\n", func_id);
+            return -1;
+        }
+        for (int i = func_cost_count; i < new_count; i++) {
+            grown[i] = 0;
+        }
+        func_costs = grown;
+        func_cost_count = new_count;
+    }
+    func_costs[func_id] = cost;
+    return 0;
+}
+
+double Runtime::func_estimate(int func_id, double* stddev) const {
+    bool measured = func_id >= 0 && func_id < RUNTIME_MAX_FUNC_ID && cost_model[func_id].samples > 0;
+    if (stddev != nullptr) {
+        *stddev = measured ? sqrt(cost_model[func_id].var) : 0.0;
+    }
+    return measured ? cost_model[func_id].mean : 0.0;
+}
+
+int Runtime::rank_cost(int func_id) const {
+    if (func_id >= 0 && func_id < func_cost_count && func_costs[func_id] > 0) {
+        return func_costs[func_id];
+    }
+    double mean = func_estimate(func_id);
+    if (mean >= INT32_MAX) {
+        return INT32_MAX;
+    }
+    return mean > 1.0 ? static_cast<int>(mean) : 1;
+}
+
+int Runtime::apply_cost_model(const FuncCost* model) {
+    memcpy(cost_model, model, sizeof(cost_model));
+    if (task_ranks == nullptr) {
+        return 0;  // finalize_graph() computes the ranks with these costs
+    }
+
+    bool moved = false;
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID && !moved; f++) {
+        int64_t cost = rank_cost(f);
+        int64_t basis = rank_basis[f];
+        moved = (cost > basis ? cost - basis : basis - cost) * 8 > basis;
+    }
+    if (!moved) {
+        return 0;
+    }
+    int* ranks = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    if (ranks == nullptr || !compute_ranks(ranks)) {
+        fprintf(stderr, "[Runtime] ERROR: Failed to recompute task ranks from measured costs\n");
+        free(ranks);
+        return -1;
+    }
+    free(task_ranks);
+    task_ranks = ranks;
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        rank_basis[f] = rank_cost(f);
+    }
+    return 1;
+}
+
+void Runtime::fold_func_samples(FuncCost* model) const {
+    for (int f = 0; f < RUNTIME_MAX_FUNC_ID; f++) {
+        const FuncSamples& batch = func_samples[f];
+        if (batch.count == 0) {
+            continue;
+        }
+        double mean = batch.sum / batch.count;
+        double var = batch.sum_sq / batch.count - mean * mean;
+        if (var < 0.0) {
+            var = 0.0;  // Rounding
+        }
+        FuncCost& cost = model[f];
+        if (cost.samples == 0) {
+            cost.mean = mean;
+            cost.var = var;
+        } else {
+            // Weight of n measurements, and the incremental EWMA variance
+            // update with the launch's spread on top
+            double weight = 1.0 - pow(1.0 - RUNTIME_COST_EWMA_ALPHA, static_cast<double>(batch.count));
+            double delta = mean - cost.mean;
+            cost.mean += weight * delta;
+            cost.var = (1.0 - weight) * (cost.var + weight * delta * delta) + weight * var;
+        }
+        cost.samples += batch.count;
+    }
+}
+
+bool Runtime::compute_ranks(int* ranks) const {
+    int n = next_task_id;
+    if (n == 0) {
+        return true;
+    }
+
+    // Topological order (Kahn) from the fanin snapshot; successors may have
+    // lower IDs than their producers when edges are added by hand
+    int* order = static_cast<int*>(malloc(n * sizeof(int)));
+    if (order == nullptr) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory computing task ranks\n");
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        ranks[i] = fanin_snapshot[i];  // Remaining fanin until ordered
+    }
+    int tail = 0;
+    for (int i = 0; i < n; i++) {
+        if (ranks[i] == 0) {
+            order[tail++] = i;
+        }
+    }
+    for (int head = 0; head < tail; head++) {
+        const TaskSched* sched = sched_at(order[head]);
+        const int* fanout = get_fanout(sched);
+        for (int j = 0; j < sched->fanout_count; j++) {
+            if (--ranks[fanout[j]] == 0) {
+                order[tail++] = fanout[j];
+            }
+        }
+    }
+    if (tail < n) {
+        fprintf(stderr, "[Runtime] ERROR: Task graph has a cycle (%d of %d tasks ordered)\n", tail, n);
+        free(order);
+        return false;
+    }
+
+    // Sinks first: path = own cost + longest successor path. Costs are at
+    // most INT32_MAX each, so no path of RUNTIME_MAX_TASKS overflows int64.
+    int64_t* paths = static_cast<int64_t*>(malloc(n * sizeof(int64_t)));
+    if (paths == nullptr) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory computing task ranks\n");
+        free(order);
+        return false;
+    }
+    int64_t longest = 0;
+    for (int k = n - 1; k >= 0; k--) {
+        int t = order[k];
+        const TaskSched* sched = sched_at(t);
+        const int* fanout = get_fanout(sched);
+        int64_t best = 0;
+        for (int j = 0; j < sched->fanout_count; j++) {
+            if (paths[fanout[j]] > best) {
+                best = paths[fanout[j]];
+            }
+        }
+        paths[t] = best + rank_cost(task_at(t)->func_id);
+        if (paths[t] > longest) {
+            longest = paths[t];
+        }
+    }
+
+    // Scale down to RUNTIME_MAX_RANK; rounding up keeps every rank >= 1
+    // and a predecessor's rank >= its successors'
+    int64_t scale = (longest + RUNTIME_MAX_RANK - 1) / RUNTIME_MAX_RANK;
+    if (scale < 1) {
+        scale = 1;
+    }
+    for (int i = 0; i < n; i++) {
+        ranks[i] = static_cast<int>((paths[i] + scale - 1) / scale);
+    }
+    free(paths);
+    free(order);
+    return true;
+}
+
+void Runtime::reset_fanin() {
+    if (fanin_snapshot == nullptr) {
+        return;
+    }
+    for (int i = 0; i < finalized_task_count; i++) {
+        sched_at(i)->fanin.store(fanin_snapshot[i], std::memory_order_relaxed);
+    }
+}
+
+void Runtime::reset_resolved() {
+    if (resolved_ids == nullptr) {
+        return;
+    }
+    for (int i = 0; i < finalized_task_count; i++) {
+        resolved_ids[i].store(0, std::memory_order_relaxed);
+    }
+    resolved_tail.store(0, std::memory_order_relaxed);
+    resolved_head.store(0, std::memory_order_release);
+}
+
+int Runtime::claim_resolved(int* task_ids, int max_tasks) {
+    int head = resolved_head.load(std::memory_order_acquire);
+    while (true) {
+        int tail = resolved_tail.load(std::memory_order_acquire);
+        int count = 0;
+        while (count < max_tasks && head + count < tail) {
+            int value = resolved_ids[head + count].load(std::memory_order_acquire);
+            if (value == 0) {
+                break;  // Reserved, not yet published
+            }
+            task_ids[count++] = value - 1;
+        }
+        if (count == 0) {
+            return 0;
+        }
+        if (resolved_head.compare_exchange_weak(head, head + count, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            return count;
+        }
+        // Another thread claimed first; head now holds its new position
+    }
+}
+
+// =============================================================================
+// Launch Topology
+// =============================================================================
+
+int Runtime::reserve_workers(int count) {
+    if (count <= 0 || block_dim <= 0 || count % block_dim != 0 || sche_cpu_num < 1 || sche_cpu_num > block_dim) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid topology: %d workers, %d blocks, %d AICPU threads\n", count,
+            block_dim, sche_cpu_num);
+        return -1;
+    }
+    worker_count = count;
+    int words = thread_doorbell_base(sche_cpu_num);
+
+    // Handshake and Doorbell are cache-line aligned, so their sizes are
+    // multiples of 64 as aligned_alloc() requires
+    if (count > worker_capacity) {
+        Handshake* grown = static_cast<Handshake*>(aligned_alloc(64, count * sizeof(Handshake)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Failed to allocate %d handshakes\n", count);
+            return -1;
+        }
+        free(workers);
+        workers = grown;
+        worker_capacity = count;
+    }
+    if (words > doorbell_capacity) {
+        Doorbell* grown = static_cast<Doorbell*>(aligned_alloc(64, words * sizeof(Doorbell)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Failed to allocate %d doorbell words\n", words);
+            return -1;
+        }
+        free(doorbells);
+        doorbells = grown;
+        doorbell_capacity = words;
+    }
+    doorbell_count = words;
+    memset(static_cast<void*>(workers), 0, count * sizeof(Handshake));
+    for (int i = 0; i < words; i++) {
+        doorbells[i].bits.store(0, std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+void Runtime::pack_edges(int* edges, int* offsets) const {
+    // Exclusive prefix sum of fanout counts gives each task's first slot
+    int offset = 0;
+    for (int i = 0; i < next_task_id; i++) {
+        offsets[i] = offset;
+        offset += sched_at(i)->fanout_count;
+    }
+
+    // Scatter edges in insertion order; offsets[i] ends at the next task's start
+    for (int e = 0; e < pending_edge_count; e++) {
+        edges[offsets[pending_edges[e].from_task]++] = pending_edges[e].to_task;
+    }
+
+    // Restore the start offsets
+    for (int i = 0; i < next_task_id; i++) {
+        offsets[i] -= sched_at(i)->fanout_count;
+    }
+}
+
+// =============================================================================
+// Dependency Inference
+// =============================================================================
+
+// Grow a realloc'd array geometrically to hold at least min_capacity items
+template <typename T>
+static bool reserve_items(T** items, int* capacity, int min_capacity) {
+    if (*capacity >= min_capacity) {
+        return true;
+    }
+    int new_capacity = *capacity > 0 ? *capacity : 64;
+    while (new_capacity < min_capacity) {
+        new_capacity *= 2;
+    }
+    T* grown = static_cast<T*>(realloc(*items, new_capacity * sizeof(T)));
+    if (grown == nullptr) {
+        return false;
+    }
+    *items = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+int Runtime::add_task(uint64_t* args, int num_args, int func_id, int core_type,
+    const TensorRegion* inputs, int num_inputs, const TensorRegion* outputs, int num_outputs) {
+    if (num_inputs < 0 || num_outputs < 0 || (num_inputs > 0 && inputs == nullptr) ||
+        (num_outputs > 0 && outputs == nullptr)) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid tensor regions\n");
+        return -1;
+    }
+
+    // Grow per-task inference state before the task exists so failure
+    // leaves nothing behind
+    if (next_task_id >= dep_task_capacity) {
+        int new_capacity = dep_task_capacity > 0 ? dep_task_capacity : 64;
+        while (new_capacity <= next_task_id) {
+            new_capacity *= 2;
+        }
+        int* marks = static_cast<int*>(realloc(dep_marks, new_capacity * sizeof(int)));
+        if (marks != nullptr) {
+            dep_marks = marks;
+        }
+        uint8_t* declared = static_cast<uint8_t*>(realloc(dep_declared, new_capacity * sizeof(uint8_t)));
+        if (declared != nullptr) {
+            dep_declared = declared;
+        }
+        if (marks == nullptr || declared == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory tracking task dependencies\n");
+            return -1;
+        }
+        // Tasks added without regions keep these cleared slots
+        for (int i = dep_task_capacity; i < new_capacity; i++) {
+            dep_marks[i] = -1;
+            dep_declared[i] = 0;
+        }
+        dep_task_capacity = new_capacity;
+    }
+    if (!reserve_regions(inputs, num_inputs, outputs, num_outputs)) {
+        return -1;
+    }
+
+    // Nothing below allocates, so the task gets all of its edges
+    int task_id = add_task(args, num_args, func_id, core_type);
+    if (task_id < 0) {
+        return -1;
+    }
+    dep_declared[task_id] = 1;
+
+    // Reads first, so an in-place task depends on the previous writer and
+    // then becomes the writer itself
+    for (int i = 0; i < num_inputs; i++) {
+        uint64_t start = reinterpret_cast<uint64_t>(inputs[i].ptr);
+        if (inputs[i].size > 0 && !track_region(task_id, start, start + inputs[i].size, false)) {
+            return -1;
+        }
+    }
+    for (int i = 0; i < num_outputs; i++) {
+        uint64_t start = reinterpret_cast<uint64_t>(outputs[i].ptr);
+        if (outputs[i].size > 0 && !track_region(task_id, start, start + outputs[i].size, true)) {
+            return -1;
+        }
+    }
+    return task_id;
+}
+
+bool Runtime::reserve_regions(const TensorRegion* inputs, int num_inputs, const TensorRegion* outputs,
+    int num_outputs) {
+    // Cover every region first; splitting segments and filling gaps with
+    // empty ones leaves the tracked state as it was
+    int regions = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        const TensorRegion* list = pass == 0 ? inputs : outputs;
+        int count = pass == 0 ? num_inputs : num_outputs;
+        for (int i = 0; i < count; i++) {
+            uint64_t start = reinterpret_cast<uint64_t>(list[i].ptr);
+            int last = 0;
+            if (list[i].size > 0 && cover_region(start, start + list[i].size, &last) < 0) {
+                return false;
+            }
+            regions += list[i].size > 0 ? 1 : 0;
+        }
+    }
+
+    // Tracking then only re-splits what an earlier write of the task
+    // merged (two segments per region), adds a reader node per segment it
+    // reads and links each earlier task at most once (dep_marks)
+    int readers = 0;
+    for (int i = 0; i < num_inputs; i++) {
+        uint64_t start = reinterpret_cast<uint64_t>(inputs[i].ptr);
+        int last = 0;
+        int first = inputs[i].size > 0 ? cover_region(start, start + inputs[i].size, &last) : 0;
+        if (first < 0) {
+            return false;
+        }
+        readers += inputs[i].size > 0 ? last - first + 2 * regions : 0;
+    }
+    if (!reserve_items(&region_segs, &region_seg_capacity, region_seg_count + 2 * regions) ||
+        !reserve_items(&reader_nodes, &reader_node_capacity, reader_node_count + readers) ||
+        !reserve_items(&pending_edges, &pending_edge_capacity, pending_edge_count + next_task_id)) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory tracking tensor regions\n");
+        return false;
+    }
+    return true;
+}
+
+bool Runtime::infer_edge(int from_task, int to_task) {
+    if (from_task == to_task || dep_marks[from_task] == to_task) {
+        return true;
+    }
+    dep_marks[from_task] = to_task;
+    return record_edge(from_task, to_task, 1);
+}
+
+bool Runtime::track_region(int task_id, uint64_t start, uint64_t end, bool write) {
+    int last = 0;
+    int first = cover_region(start, end, &last);
+    if (first < 0) {
+        return false;
+    }
+
+    for (int i = first; i < last; i++) {
+        RuntimeRegionSeg* seg = &region_segs[i];
+        if (!write) {
+            // RAW: depend on the last writer, then join the readers
+            if (seg->writer >= 0 && !infer_edge(seg->writer, task_id)) {
+                return false;
+            }
+            if (reader_node_count >= reader_node_capacity) {
+                int new_capacity = reader_node_capacity > 0 ? reader_node_capacity * 2 : 64;
+                RuntimeReaderNode* grown = static_cast<RuntimeReaderNode*>(
+                    realloc(reader_nodes, new_capacity * sizeof(RuntimeReaderNode)));
+                if (grown == nullptr) {
+                    fprintf(stderr, "[Runtime] ERROR: Out of memory tracking readers\n");
+                    return false;
+                }
+                reader_nodes = grown;
+                reader_node_capacity = new_capacity;
+            }
+            reader_nodes[reader_node_count].task_id = task_id;
+            reader_nodes[reader_node_count].next = seg->readers;
+            seg->readers = reader_node_count++;
+            continue;
+        }
+
+        // WAR: depend on every reader since the last write. Each of them
+        // already depends on the writer, so WAW is only needed without readers.
+        bool has_readers = false;
+        for (int r = seg->readers; r >= 0; r = reader_nodes[r].next) {
+            if (reader_nodes[r].task_id == task_id) {
+                continue;
+            }
+            has_readers = true;
+            if (!infer_edge(reader_nodes[r].task_id, task_id)) {
+                return false;
+            }
+        }
+        if (!has_readers && seg->writer >= 0 && !infer_edge(seg->writer, task_id)) {
+            return false;
+        }
+    }
+
+    if (write) {
+        // The written range now has one state; collapse it into one segment
+        region_segs[first].end = region_segs[last - 1].end;
+        region_segs[first].writer = task_id;
+        region_segs[first].readers = -1;
+        if (last - first > 1) {
+            memmove(&region_segs[first + 1], &region_segs[last],
+                (region_seg_count - last) * sizeof(RuntimeRegionSeg));
+            region_seg_count -= last - first - 1;
+        }
+    }
+    return true;
+}
+
+int Runtime::cover_region(uint64_t start, uint64_t end, int* last) {
+    // First segment ending after start (segments are sorted and disjoint)
+    int lo = 0;
+    int hi = region_seg_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (region_segs[mid].end <= start) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    int first = lo;
+
+    // Split a segment straddling start
+    if (first < region_seg_count && region_segs[first].start < start) {
+        RuntimeRegionSeg seg = region_segs[first];
+        if (!insert_region_seg(first + 1, start, seg.end, seg.writer, seg.readers)) {
+            return -1;
+        }
+        region_segs[first].end = start;
+        first++;
+    }
+
+    // Walk the range, filling gaps and splitting a segment straddling end
+    uint64_t cur = start;
+    int i = first;
+    while (cur < end) {
+        if (i < region_seg_count && region_segs[i].start <= cur) {
+            if (region_segs[i].end > end) {
+                RuntimeRegionSeg seg = region_segs[i];
+                if (!insert_region_seg(i + 1, end, seg.end, seg.writer, seg.readers)) {
+                    return -1;
+                }
+                region_segs[i].end = end;
+            }
+        } else {
+            uint64_t gap_end = end;
+            if (i < region_seg_count && region_segs[i].start < end) {
+                gap_end = region_segs[i].start;
+            }
+            if (!insert_region_seg(i, cur, gap_end, -1, -1)) {
+                return -1;
+            }
+        }
+        cur = region_segs[i].end;
+        i++;
+    }
+    *last = i;
+    return first;
+}
+
+bool Runtime::insert_region_seg(int index, uint64_t start, uint64_t end, int writer, int readers) {
+    if (region_seg_count >= region_seg_capacity) {
+        int new_capacity = region_seg_capacity > 0 ? region_seg_capacity * 2 : 64;
+        RuntimeRegionSeg* grown =
+            static_cast<RuntimeRegionSeg*>(realloc(region_segs, new_capacity * sizeof(RuntimeRegionSeg)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory tracking tensor regions\n");
+            return false;
+        }
+        region_segs = grown;
+        region_seg_capacity = new_capacity;
+    }
+    memmove(&region_segs[index + 1], &region_segs[index], (region_seg_count - index) * sizeof(RuntimeRegionSeg));
+    region_segs[index].start = start;
+    region_segs[index].end = end;
+    region_segs[index].writer = writer;
+    region_segs[index].readers = readers;
+    region_seg_count++;
+    return true;
+}
+
+int Runtime::report_unneeded_edges() const {
+    // Inferred successor lists (CSR) to test whether a hand-written edge is
+    // already implied
+    int n = next_task_id;
+    int* offsets = static_cast<int*>(malloc((n + 1) * sizeof(int)));
+    int* edges = static_cast<int*>(malloc((pending_edge_count > 0 ? pending_edge_count : 1) * sizeof(int)));
+    int* visited = static_cast<int*>(malloc((n > 0 ? n : 1) * sizeof(int)));
+    int* stack = static_cast<int*>(malloc((n > 0 ? n : 1) * sizeof(int)));
+    if (offsets == nullptr || edges == nullptr || visited == nullptr || stack == nullptr) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory checking hand-written edges\n");
+        free(offsets);
+        free(edges);
+        free(visited);
+        free(stack);
+        return 0;
+    }
+    memset(offsets, 0, (n + 1) * sizeof(int));
+    for (int e = 0; e < pending_edge_count; e++) {
+        if (pending_edges[e].inferred) {
+            offsets[pending_edges[e].from_task + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+        visited[i] = -1;
+    }
+    for (int e = 0; e < pending_edge_count; e++) {
+        if (pending_edges[e].inferred) {
+            edges[offsets[pending_edges[e].from_task]++] = pending_edges[e].to_task;
+        }
+    }
+    for (int i = n; i > 0; i--) {
+        offsets[i] = offsets[i - 1];
+    }
+    offsets[0] = 0;
+
+    int manual = 0;
+    int unneeded = 0;
+    for (int e = 0; e < pending_edge_count; e++) {
+        const RuntimeEdge& edge = pending_edges[e];
+        if (edge.inferred) {
+            continue;
+        }
+        manual++;
+        if (dep_declared == nullptr || edge.from_task >= dep_task_capacity || edge.to_task >= dep_task_capacity ||
+            !dep_declared[edge.from_task] || !dep_declared[edge.to_task]) {
+            continue;
+        }
+
+        // Inferred edges always point to later tasks, so the search can
+        // skip every task after to_task
+        bool reached = false;
+        int top = 0;
+        stack[top++] = edge.from_task;
+        visited[edge.from_task] = e;
+        while (top > 0 && !reached) {
+            int t = stack[--top];
+            for (int j = offsets[t]; j < offsets[t + 1]; j++) {
+                int next = edges[j];
+                if (next == edge.to_task) {
+                    reached = true;
+                    break;
+                }
+                if (next < edge.to_task && visited[next] != e) {
+                    visited[next] = e;
+                    stack[top++] = next;
+                }
+            }
+        }
+
+        printf("[Runtime] Unneeded edge %d -> %d: %s\n", edge.from_task, edge.to_task,
+            reached ? "implied by inferred dependencies" : "no data dependency");
+        unneeded++;
+    }
+    printf("[Runtime] Hand-written edges: %d, unneeded: %d\n", manual, unneeded);
+
+    free(offsets);
+    free(edges);
+    free(visited);
+    free(stack);
+    return unneeded;
 }
 
 // =============================================================================
@@ -106,23 +938,22 @@ Task* Runtime::get_task(int task_id) {
     if (task_id < 0 || task_id >= next_task_id) {
         return nullptr;
     }
-    return &tasks[task_id];
+    return task_at(task_id);
 }
 
 int Runtime::get_task_count() const { return next_task_id; }
 
 int Runtime::get_initial_ready_tasks(int* ready_tasks) {
-    initial_ready_count = 0;
+    int count = 0;
     for (int i = 0; i < next_task_id; i++) {
-        if (tasks[i].fanin == 0) {
-            initial_ready_tasks[initial_ready_count] = i;
+        if (sched_at(i)->fanin == 0) {
             if (ready_tasks != nullptr) {
-                ready_tasks[initial_ready_count] = i;
+                ready_tasks[count] = i;
             }
-            initial_ready_count++;
+            count++;
         }
     }
-    return initial_ready_count;
+    return count;
 }
 
 // =============================================================================
@@ -147,7 +978,7 @@ void Runtime::print_runtime() const {
     printf("  ");
     int ready_count = 0;
     for (int i = 0; i < next_task_id; i++) {
-        if (tasks[i].fanin.load() == 0) {
+        if (sched_at(i)->fanin.load() == 0) {
             if (ready_count > 0) printf(", ");
             printf("%d", i);
             ready_count++;
@@ -163,22 +994,36 @@ void Runtime::print_runtime() const {
         "----------------------------------------------------------------------"
         "----------\n");
 
+    // Successor lists may not be packed yet (e.g. printed from orchestration)
+    int* edges = static_cast<int*>(malloc((pending_edge_count > 0 ? pending_edge_count : 1) * sizeof(int)));
+    int* offsets = static_cast<int*>(malloc((next_task_id > 0 ? next_task_id : 1) * sizeof(int)));
+    if (edges == nullptr || offsets == nullptr) {
+        fprintf(stderr, "[Runtime] ERROR: Out of memory printing runtime\n");
+        free(edges);
+        free(offsets);
+        return;
+    }
+    pack_edges(edges, offsets);
+
     for (int i = 0; i < next_task_id; i++) {
-        const Task* t = &tasks[i];
+        const Task* t = task_at(i);
+        const TaskSched* s = sched_at(i);
 
         printf("  Task %d: func_id=%d, fanin=%d, fanout=%d, args=%d [",
             i,
             t->func_id,
-            t->fanin.load(),
-            t->fanout_count,
+            s->fanin.load(),
+            s->fanout_count,
             t->num_args);
 
         // Print fanout list
-        for (int j = 0; j < t->fanout_count; j++) {
-            printf("%d%s", t->fanout[j], j < t->fanout_count - 1 ? "," : "");
+        for (int j = 0; j < s->fanout_count; j++) {
+            printf("%d%s", edges[offsets[i] + j], j < s->fanout_count - 1 ? "," : "");
         }
         printf("]\n");
     }
+    free(edges);
+    free(offsets);
 
     printf(
         "======================================================================"
@@ -212,3 +1057,109 @@ int Runtime::get_tensor_pair_count() const {
 void Runtime::clear_tensor_pairs() {
     tensor_pair_count = 0;
 }
+
+// =============================================================================
+// Graph Parameters
+// =============================================================================
+
+// Length of a parameter name, or RUNTIME_MAX_PARAM_NAME if it does not fit.
+// Plain loops keep this file free of string library calls for device builds.
+static int param_name_length(const char* name) {
+    int len = 0;
+    while (len < RUNTIME_MAX_PARAM_NAME && name[len] != '\0') {
+        len++;
+    }
+    return len;
+}
+
+int Runtime::find_param(const char* name) const {
+    int len = param_name_length(name);
+    for (int i = 0; i < param_count; i++) {
+        if (memcmp(params[i].name, name, len + 1) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int Runtime::bind_param(const char* name, int task_id, int arg_index) {
+    int name_len = name != nullptr ? param_name_length(name) : 0;
+    if (name_len == 0 || name_len >= RUNTIME_MAX_PARAM_NAME) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid parameter name (max length %d)\n", RUNTIME_MAX_PARAM_NAME - 1);
+        return -1;
+    }
+    if (task_id < 0 || task_id >= next_task_id) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid task ID %d for parameter '%s'\n", task_id, name);
+        return -1;
+    }
+    if (arg_index < 0 || arg_index >= task_at(task_id)->num_args) {
+        fprintf(stderr, "[Runtime] ERROR: Invalid arg index %d of task %d for parameter '%s'\n",
+            arg_index, task_id, name);
+        return -1;
+    }
+
+    int p = find_param(name);
+    if (p < 0) {
+        if (param_count >= param_capacity) {
+            int new_capacity = param_capacity > 0 ? param_capacity * 2 : 8;
+            RuntimeParam* grown = static_cast<RuntimeParam*>(realloc(params, new_capacity * sizeof(RuntimeParam)));
+            if (grown == nullptr) {
+                fprintf(stderr, "[Runtime] ERROR: Out of memory adding parameter '%s'\n", name);
+                return -1;
+            }
+            params = grown;
+            param_capacity = new_capacity;
+        }
+        p = param_count++;
+        memset(&params[p], 0, sizeof(RuntimeParam));
+        memcpy(params[p].name, name, name_len + 1);
+        params[p].first_slot = -1;
+        params[p].last_slot = -1;
+    }
+
+    // Grow the slot array geometrically
+    if (param_slot_count >= param_slot_capacity) {
+        int new_capacity = param_slot_capacity > 0 ? param_slot_capacity * 2 : 64;
+        RuntimeParamSlot* grown =
+            static_cast<RuntimeParamSlot*>(realloc(param_slots, new_capacity * sizeof(RuntimeParamSlot)));
+        if (grown == nullptr) {
+            fprintf(stderr, "[Runtime] ERROR: Out of memory binding parameter '%s'\n", name);
+            return -1;
+        }
+        param_slots = grown;
+        param_slot_capacity = new_capacity;
+    }
+
+    // Append so slots keep binding order (adjacent words stay adjacent)
+    int slot = param_slot_count++;
+    param_slots[slot].task_id = task_id;
+    param_slots[slot].arg_index = arg_index;
+    param_slots[slot].next = -1;
+    if (params[p].last_slot >= 0) {
+        param_slots[params[p].last_slot].next = slot;
+    } else {
+        params[p].first_slot = slot;
+    }
+    params[p].last_slot = slot;
+    params[p].slot_count++;
+    return 0;
+}
+
+int Runtime::set_param(const char* name, uint64_t value) {
+    int p = (name != nullptr && param_name_length(name) < RUNTIME_MAX_PARAM_NAME) ? find_param(name) : -1;
+    if (p < 0) {
+        fprintf(stderr, "[Runtime] ERROR: Unknown parameter '%s'\n", name != nullptr ? name : "(null)");
+        return -1;
+    }
+    for (int s = params[p].first_slot; s >= 0; s = param_slots[s].next) {
+        task_at(param_slots[s].task_id)->args[param_slots[s].arg_index] = value;
+    }
+    params[p].dirty = 1;
+    return params[p].slot_count;
+}
+
+void Runtime::clear_param_dirty() {
+    for (int i = 0; i < param_count; i++) {
+        params[i].dirty = 0;
+    }
+}
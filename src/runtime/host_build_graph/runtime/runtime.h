@@ -2,12 +2,12 @@
  * Runtime Class - Task Dependency Runtime Management
  *
  * This is a simplified, standalone runtime class for managing task
- * dependencies. Tasks are stored in a fixed-size array with compile-time
- * configurable bounds. Each task has:
+ * dependencies. Tasks are stored in fixed-size chunks that are allocated on
+ * demand, so task addresses stay stable as the graph grows. Each task has:
  * - Unique ID (array index)
  * - Arguments (uint64_t array)
  * - Fanin (predecessor count)
- * - Fanout (array of successor task IDs)
+ * - Fanout (slice of the packed successor edge array, CSR layout)
  *
  * The runtime maintains a ready queue for tasks with fanin == 0.
  *
@@ -29,26 +29,88 @@
 // Configuration Macros
 // =============================================================================
 
-#ifndef RUNTIME_MAX_TASKS
-#define RUNTIME_MAX_TASKS 1024
+#ifndef RUNTIME_TASK_CHUNK_SHIFT
+#define RUNTIME_TASK_CHUNK_SHIFT 10
 #endif
 
-#ifndef RUNTIME_MAX_ARGS
-#define RUNTIME_MAX_ARGS 16
+#define RUNTIME_TASK_CHUNK_SIZE (1 << RUNTIME_TASK_CHUNK_SHIFT)  // Tasks per chunk
+
+#ifndef RUNTIME_MAX_TASK_CHUNKS
+#define RUNTIME_MAX_TASK_CHUNKS 256
 #endif
 
-#ifndef RUNTIME_MAX_FANOUT
-#define RUNTIME_MAX_FANOUT 512
+// Upper bound on tasks per runtime; only the chunk table scales with it
+#define RUNTIME_MAX_TASKS (RUNTIME_TASK_CHUNK_SIZE * RUNTIME_MAX_TASK_CHUNKS)
+
+#ifndef RUNTIME_MAX_ARGS
+#define RUNTIME_MAX_ARGS 16
 #endif
 
+// AICores of one a2a3 device (24 AIC + 48 AIV). Handshake storage is sized
+// per launch by reserve_workers(), so this only bounds a2a3 launches; the
+// simulator takes any block_dim.
 #ifndef RUNTIME_MAX_WORKER
-#define RUNTIME_MAX_WORKER 72  // 24 AIC + 48 AIV cores
+#define RUNTIME_MAX_WORKER 72
 #endif
 
 #ifndef RUNTIME_MAX_TENSOR_PAIRS
 #define RUNTIME_MAX_TENSOR_PAIRS 64
 #endif
 
+#ifndef RUNTIME_MAX_MAILBOX_DEPTH
+#define RUNTIME_MAX_MAILBOX_DEPTH 4  // Task slots per core mailbox (power of two)
+#endif
+
+#ifndef RUNTIME_MAX_PARAM_NAME
+#define RUNTIME_MAX_PARAM_NAME 32  // Including the terminating NUL
+#endif
+
+#ifndef RUNTIME_MAX_FUNC_ID
+#define RUNTIME_MAX_FUNC_ID 64  // func_ids [0, N) covered by the online cost model
+#endif
+
+// Weight of each measured task duration in the cost model's moving
+// averages (see Runtime::fold_func_samples())
+#ifndef RUNTIME_COST_EWMA_ALPHA
+#define RUNTIME_COST_EWMA_ALPHA 0.125
+#endif
+
+// Ceiling of the upward ranks (Runtime::task_ranks). Weighted path costs
+// above it, e.g. long chains of measured durations in timer ticks, are
+// scaled down to fit, so priority arithmetic stays far from INT32_MAX.
+#ifndef RUNTIME_MAX_RANK
+#define RUNTIME_MAX_RANK (1 << 24)
+#endif
+
+// Core partitions of one device, and so runtimes that can be in flight on
+// it at once: each partition has its own AICPU executor instance
+#ifndef RUNTIME_MAX_PARTITIONS
+#define RUNTIME_MAX_PARTITIONS 8
+#endif
+
+// Cores a MIX task runs on: the AIC (role 0) and both AIVs (roles 1, 2) of a block
+#define RUNTIME_MIX_ROLES 3
+
+// AICPU scheduling policies (Runtime::sched_policy)
+#define RUNTIME_SCHED_GRAPH -1          // Order and placement chosen by the orchestration
+#define RUNTIME_SCHED_FIFO 0            // Arrival order, any idle core
+#define RUNTIME_SCHED_LIFO 1            // Most recently enabled (deepest) first
+#define RUNTIME_SCHED_CRITICAL_PATH 2   // Highest upward rank first
+#define RUNTIME_SCHED_SHORTEST_JOB 3    // Cheapest task first
+#define RUNTIME_SCHED_LOCALITY 4        // Arrival order, producer's core first
+#define RUNTIME_SCHED_POLICY_COUNT 5
+
+// Idle waiting of AICores and AICPU threads (Runtime::idle_wait). Every mode
+// first polls idle_spin times; yield then pauses between polls
+// (aicore_spin_pause() / aicpu_spin_pause()), and block pauses for
+// idle_yield more polls and then sleeps on a wake word until the other side
+// writes. Pausing and sleeping are simulation features: on hardware the
+// platform hooks are no-ops and every mode polls.
+#define RUNTIME_WAIT_SPIN 0
+#define RUNTIME_WAIT_YIELD 1
+#define RUNTIME_WAIT_BLOCK 2
+#define RUNTIME_WAIT_MODE_COUNT 3
+
 // =============================================================================
 // Data Structures
 // =============================================================================
@@ -62,11 +124,23 @@
  * Protocol State Machine:
  * 1. Initialization: AICPU sets aicpu_ready=1
  * 2. Acknowledgment: AICore sets aicore_done=core_id+1
- * 3. Task Dispatch: AICPU assigns task pointer and sets task_status=1
- * 4. Task Execution: AICore reads task, executes, sets task_status=0
- * 5. Task Completion: AICPU reads task_status=0, clears task=0
+ * 3. Task Dispatch: AICPU writes the task pointer into
+ *    tasks[post_count % RUNTIME_MAX_MAILBOX_DEPTH], then bumps post_count
+ * 4. Task Execution: AICore takes each posted slot in order, executes the
+ *    task (and, with Runtime::chain_successors, its chain successors) and
+ *    bumps done_count after every task it ran
+ * 5. Task Completion: AICore rings its doorbell bit in
+ *    Runtime::doorbells; the AICPU thread managing the core takes its
+ *    doorbell words, finds the rung cores with count-trailing-zeros, sees
+ *    done_count advance, replays the same slot/chain sequence to tell which
+ *    tasks finished and frees the slots
  * 6. Shutdown: AICPU sets control=1, AICore exits
  *
+ * The task slots form a per-core mailbox ring. The AICPU keeps at most
+ * Runtime::mailbox_depth tasks posted but not completed, so with a depth
+ * above 1 the next task is already staged when the current one finishes
+ * and the core moves on without waiting for the AICPU round trip.
+ *
  * Each AICore instance has its own handshake buffer to enable concurrent
  * task execution across multiple cores.
  */
@@ -81,18 +155,46 @@
  * Field Access Patterns:
  * - aicpu_ready: Written by AICPU, read by AICore
  * - aicore_done: Written by AICore, read by AICPU
- * - task: Written by AICPU, read by AICore (0 = no task assigned)
- * - task_status: Written by both (AICPU=1 on dispatch, AICore=0 on completion)
+ * - tasks: Written by AICPU, read by AICore (Task* addresses)
+ * - post_count: Written by AICPU, read by AICore (tasks posted so far)
  * - control: Written by AICPU, read by AICore (0 = continue, 1 = quit)
  * - core_type: Written by AICPU, read by AICore (0 = AIC, 1 = AIV)
+ * - doorbell_word, doorbell_mask: Written by AICPU before aicpu_ready, read
+ *   by AICore (the Runtime::doorbells word and bit it rings on completion)
+ * - done_count: Written by AICore, read by AICPU (tasks completed so far,
+ *   chained ones included); kept on its own cache line so completions and
+ *   dispatches do not invalidate each other
+ * - mix_role, mix_leader: Written by AICPU before aicpu_ready, read by
+ *   AICore (the core's role in a MIX gang and the handshake index of its
+ *   block's AIC)
+ * - mix_arrived: Only used in the AIC's handshake; every core of the block
+ *   adds an arrival for each gang barrier (see CoreType::MIX)
+ * - wake_word: Armed by an AICore about to sleep (RUNTIME_WAIT_BLOCK), rung
+ *   by the AICPU after writing aicpu_ready, post_count or control
  */
 struct Handshake {
-    volatile uint32_t aicpu_ready;  // AICPU ready signal: 0=not ready, 1=ready
-    volatile uint32_t aicore_done;  // AICore ready signal: 0=not ready, core_id+1=ready
-    volatile uint64_t task;         // Task pointer: 0=no task, non-zero=Task* address
-    volatile int32_t task_status;   // Task execution status: 0=idle, 1=busy
-    volatile int32_t control;       // Control signal: 0=execute, 1=quit
-    volatile int32_t core_type;     // Core type: 0=AIC, 1=AIV
+    volatile uint32_t aicpu_ready;                       // AICPU ready signal: 0=not ready, 1=ready
+    volatile uint32_t aicore_done;                       // AICore ready signal: 0=not ready, core_id+1=ready
+    volatile uint64_t tasks[RUNTIME_MAX_MAILBOX_DEPTH];  // Mailbox ring of Task* addresses
+    volatile uint32_t post_count;                        // Tasks posted by AICPU
+    volatile int32_t control;                            // Control signal: 0=execute, 1=quit
+    volatile int32_t core_type;                          // Core type: 0=AIC, 1=AIV
+    volatile uint32_t doorbell_word;                     // Index into Runtime::doorbells
+    volatile uint64_t doorbell_mask;                     // This core's bit in that word
+    volatile int32_t mix_role;                           // 0=AIC, 1/2=first/second AIV of the block
+    volatile uint32_t mix_leader;                        // Handshake index of the block's AIC
+    volatile uint32_t wake_word;                         // Wakes the AICore from a blocked idle wait
+    volatile uint32_t done_count __attribute__((aligned(64)));  // Tasks completed by AICore
+    std::atomic<uint32_t> mix_arrived __attribute__((aligned(64)));  // Gang barrier arrivals (AIC only)
+} __attribute__((aligned(64)));
+
+/**
+ * Completion doorbell word: one bit per core, set by the core when it
+ * finishes a task and taken (swapped to zero) by the AICPU thread that
+ * manages it. Each word has its own cache line.
+ */
+struct Doorbell {
+    std::atomic<uint64_t> bits;
 } __attribute__((aligned(64)));
 
 /**
@@ -101,10 +203,19 @@ struct Handshake {
  * Specifies which AICore type a task should run on.
  * AIC (AICore Compute) handles compute-intensive operations.
  * AIV (AICore Vector) handles vector/SIMD operations.
+ * MIX tasks are gang-scheduled on the AIC and both AIVs of one block, which
+ * all run the kernel together. A MIX kernel has the signature
+ *     void kernel(__gm__ int64_t* args, int role, __gm__ uint32_t* barrier)
+ * where role is the core's mix_role and barrier the block's arrival count.
+ * To synchronize the gang every core atomically adds 1 and waits until the
+ * count reaches the next multiple of RUNTIME_MIX_ROLES (kernels are loaded
+ * without linking, so they implement the barrier inline). Every core must
+ * pass the same number of barriers.
  */
 enum class CoreType : int {
     AIC = 0,  // AICore Compute
-    AIV = 1   // AICore Vector
+    AIV = 1,  // AICore Vector
+    MIX = 2   // AIC + 2 AIV of one block, gang-scheduled
 };
 
 /**
@@ -129,36 +240,139 @@ struct HostApi {
 };
 
 /**
- * Task entry in the runtime
+ * Dependency edge recorded by add_successor() before the graph is finalized
+ */
+struct RuntimeEdge {
+    int from_task;  // Producer task ID
+    int to_task;    // Consumer task ID
+    int inferred;   // 1 if derived from tensor regions, 0 if added by hand
+};
+
+/**
+ * Device memory region a task reads or writes: [ptr, ptr + size)
+ */
+struct TensorRegion {
+    void* ptr;
+    size_t size;
+};
+
+/**
+ * Segment of the dependency tracker's interval map (host-only)
  *
- * Each task has a unique ID (its index in the task array), arguments,
- * and dependency information (fanin/fanout).
+ * The tracked address space is split into disjoint segments, each with the
+ * task that last wrote it and the tasks that read it since that write.
+ */
+struct RuntimeRegionSeg {
+    uint64_t start;  // First byte covered
+    uint64_t end;    // One past the last byte covered
+    int writer;      // Last task that wrote the segment, -1 if none
+    int readers;     // Head of the reader list since that write, -1 if none
+};
+
+/**
+ * Reader list node (host-only). Lists are only ever prepended to, so
+ * segments split from one another can share their tails.
+ */
+struct RuntimeReaderNode {
+    int task_id;
+    int next;  // Next (earlier) reader, -1 at the end
+};
+
+/**
+ * Named graph parameter (host-only)
+ *
+ * A set of task argument words that are rebound together between replays,
+ * e.g. every task argument that holds the device address of "input_a".
+ * Its slots form a list in Runtime's slot array via RuntimeParamSlot::next.
+ */
+struct RuntimeParam {
+    char name[RUNTIME_MAX_PARAM_NAME];
+    int first_slot;  // First slot of this parameter, -1 if none
+    int last_slot;   // Last slot (append point), -1 if none
+    int slot_count;  // Number of argument words bound to this parameter
+    int dirty;       // Rebound since the device copy was last updated
+};
+
+/**
+ * One task argument word bound to a named parameter (host-only)
+ */
+struct RuntimeParamSlot {
+    int task_id;    // Task whose argument is patched
+    int arg_index;  // Index into Task::args
+    int next;       // Next slot of the same parameter, -1 at the end
+};
+
+/**
+ * Task scheduling metadata (hot)
+ *
+ * Everything the AICPU scheduler reads or writes when a task completes or
+ * is dispatched. Kept apart from the task payload so that resolving a
+ * successor touches one 16-byte record instead of the whole Task.
+ * Successor IDs are not stored inline: finalize_graph() packs every
+ * successor list into one contiguous edge array, and the record keeps its
+ * offset and length into it.
  */
 typedef struct {
-    int task_id;                      // Unique task identifier
-    int func_id;                      // Function identifier
-    uint64_t args[RUNTIME_MAX_ARGS];  // Task arguments
-    int num_args;                     // Number of valid arguments
+    std::atomic<int> fanin;  // Number of unfinished predecessors
+    int fanout_offset;       // First successor in Runtime::fanout_edges
+    int fanout_count;        // Number of successors
+    int core_type;           // Core type this task runs on: 0=AIC, 1=AIV, 2=MIX
+} TaskSched;
 
+/**
+ * Task payload (cold)
+ *
+ * Each task has a unique ID (its index in the task store), a kernel and its
+ * arguments. The handshake passes a pointer to this payload to the AICore,
+ * which only reads function_bin_addr and args; the AICPU scheduler does not
+ * touch it on the hot path. Dependency state lives in the task's TaskSched.
+ */
+typedef struct {
     // Runtime function pointer address (NEW)
     // This is the GM address where the kernel binary resides
     // It's cast to a function pointer at runtime: (KernelFunc)function_bin_addr
     uint64_t function_bin_addr;  // Address of kernel in device GM memory
 
-    // Core type specification (NEW)
-    // Specifies which core type this task should run on: 0=AIC, 1=AIV
-    int core_type;  // 0=AIC, 1=AIV
-
-    // Dependency tracking (using PTO runtime terminology)
-    std::atomic<int> fanin;          // Number of predecessors (dependencies)
-    int fanout[RUNTIME_MAX_FANOUT];  // Successor task IDs
-    int fanout_count;                // Number of successors
+    uint64_t args[RUNTIME_MAX_ARGS];  // Task arguments
+    int num_args;                     // Number of valid arguments
+    int task_id;                      // Unique task identifier
+    int func_id;                      // Function identifier
 
-    // DFX-specific fields
+    // DFX-specific fields, stamped by the AICore that runs the task (the
+    // AIC for a MIX task) in device timer ticks; they feed the cost model
     uint64_t start_time;  // Start time of the task
     uint64_t end_time;    // End time of the task
 } Task;
 
+/**
+ * Measured execution time of one kernel (func_id): exponentially weighted
+ * moving average and variance of its task durations, in device timer ticks
+ * (nanoseconds on the simulator)
+ */
+struct FuncCost {
+    uint64_t samples;  // Tasks measured so far, 0 = no estimate
+    double mean;       // Moving average of the duration
+    double var;        // Moving average of the squared deviation from mean
+};
+
+/**
+ * Durations of one kernel's tasks measured during a single launch
+ */
+struct FuncSamples {
+    uint64_t count;
+    double sum;
+    double sum_sq;
+};
+
+/**
+ * One chunk of the task store: the hot scheduling records of
+ * RUNTIME_TASK_CHUNK_SIZE tasks followed by their payloads.
+ */
+struct TaskChunk {
+    TaskSched sched[RUNTIME_TASK_CHUNK_SIZE];
+    Task tasks[RUNTIME_TASK_CHUNK_SIZE];
+};
+
 // =============================================================================
 // Runtime Class
 // =============================================================================
@@ -166,30 +380,158 @@ typedef struct {
 /**
  * Runtime class for task dependency management
  *
- * Maintains a fixed-size array of tasks and uses a Queue for ready tasks.
+ * Maintains a chunked task store and uses a Queue for ready tasks.
  * Tasks are allocated monotonically and never reused within the same
- * runtime instance.
+ * runtime instance. Chunks are never moved or freed before destruction, so
+ * Task* pointers handed to the AICore stay valid.
  *
- * Dependencies are managed manually via add_successor().
+ * Dependencies are managed manually via add_successor() and packed into
+ * compressed-sparse-row form by finalize_graph() before launch.
  */
 class Runtime {
 public:
-    // Handshake buffers for AICPU-AICore communication
-    Handshake workers[RUNTIME_MAX_WORKER];  // Worker (AICore) handshake buffers
-    int worker_count;                       // Number of active workers
+    // Handshake buffers for AICPU-AICore communication, one per worker
+    // (AICore), allocated by reserve_workers() for the launch. The host
+    // rewrites this pointer to the uploaded copy on real devices.
+    Handshake* workers;
+    int worker_count;  // Number of active workers
 
     // Execution parameters for AICPU scheduling
-    int block_dim;     // Number of AIC blocks (block dimension)
-    int sche_cpu_num;  // Number of AICPU threads for scheduling
+    int block_dim;      // Number of AIC blocks (block dimension)
+    int sche_cpu_num;   // Number of AICPU threads for scheduling
+    int mailbox_depth;  // Tasks in flight per core (1..RUNTIME_MAX_MAILBOX_DEPTH)
+
+    // Hierarchical scheduling: with a value above 1 the AICPU threads form
+    // groups of this many, each led by a coordinator (its first thread).
+    // Threads steal and move blocks within their group only; coordinators
+    // sum their group's completions for everyone and move ready tasks
+    // between groups. 0 or 1 = every thread deals with every other.
+    int sched_group_size;
+
+    // Core partition the runtime is launched on (0..RUNTIME_MAX_PARTITIONS-1),
+    // set by the host. Runtimes on disjoint blocks of a device run
+    // concurrently, each scheduled by its partition's AICPU executor
+    // instance; launch_runtime() uses partition 0.
+    int partition;
+
+    // Dependency resolution mode: 0 = the AICPU walks each completed task's
+    // fanout, 1 = the AICore does it right after executing the task and
+    // publishes the successors it made ready to the resolved queue below;
+    // the AICPU then only places and dispatches them
+    int resolve_on_aicore;
+
+    // Core rebalancing: 1 = an AICPU thread whose cores complete tasks at
+    // under half the per-block rate of another thread's hands that thread
+    // one of its idle blocks (rates measured over windows of completions)
+    int rebalance_cores;
+
+    // Continuation chaining: 1 = a core that finishes a task runs its chain
+    // successor (see chain_next) right away instead of waiting for the
+    // AICPU to dispatch it
+    int chain_successors;
+
+    // Idle waiting (RUNTIME_WAIT_*), set by the host for every launch: an
+    // idle AICore or AICPU thread polls idle_spin times, then (yield and
+    // block) pauses between polls, and in block mode sleeps after idle_yield
+    // pausing polls. Blocked AICPU threads sleep on sched_wake, rung by
+    // cores after every completion and by AICPU threads that made progress.
+    int idle_wait;
+    int idle_spin;
+    int idle_yield;
+    volatile uint32_t sched_wake __attribute__((aligned(64)));
+
+    // Packed successor lists (CSR), built by finalize_graph(). Task i's
+    // successors are fanout_edges[fanout_offset, fanout_offset + fanout_count).
+    // The host rewrites this pointer to the uploaded copy on real devices.
+    int* fanout_edges;
+    int fanout_edge_count;
+
+    // Fanin of every task as built, captured by finalize_graph(). Scheduling
+    // consumes TaskSched::fanin, so each launch restores it from here
+    // (reset_fanin()), which lets the same graph be replayed. The host
+    // rewrites this pointer to the uploaded copy on real devices.
+    int* fanin_snapshot;
+
+    // Upward rank of every task: the cost of the longest path from the task
+    // to a sink, including itself, weighted by set_func_cost(). If the
+    // longest path exceeds RUNTIME_MAX_RANK, all ranks are divided by the
+    // same factor (rounding up) to fit. Computed by finalize_graph(); the
+    // scheduler dispatches higher ranks first. The host rewrites this
+    // pointer to the uploaded copy on real devices.
+    int* task_ranks;
+
+    // Chain successor of every task, -1 if none: the first successor (in
+    // fanout order) of the same core type whose only predecessor is this
+    // task. Such a successor is ready exactly when its predecessor
+    // finishes, so with chain_successors the core runs it next and the
+    // AICPU, following the same table, accounts for it afterwards without
+    // ever queueing it. MIX tasks neither chain nor are chained, since a
+    // gang needs all three cores of a block. Computed by finalize_graph();
+    // the host rewrites this pointer to the uploaded copy on real devices.
+    int* chain_next;
+
+    // Ready queue order: 1 = highest rank first (critical path, default),
+    // 0 = arrival order (FIFO)
+    int schedule_by_rank;
+
+    // Core placement: 0 = any idle core, 1 = locality. With locality a task
+    // made ready by a completion is held for the block of the core that
+    // produced its input; that core (or another core of the same type in the
+    // block) takes it when idle. After locality_wait scheduler rounds
+    // without such a core the task falls back to the ready queues and any
+    // idle core. Applies to successors resolved on the AICPU.
+    int placement_policy;
+    int locality_wait;
+
+    // Scheduling policy for this launch (RUNTIME_SCHED_*), set by the host
+    // from launch_runtime(). RUNTIME_SCHED_GRAPH keeps schedule_by_rank and
+    // placement_policy as the orchestration set them; any other value
+    // replaces both with the named policy.
+    int sched_policy;
+
+    // Online cost model. cost_model holds the per-func_id estimates the host
+    // keeps across launches (and runtimes), copied in by apply_cost_model()
+    // before orchestration and before every launch: ranks use them for
+    // kernels without a set_func_cost(), and orchestration and policies can
+    // read them through func_estimate(). func_samples receives the launch's
+    // measured durations, summed by the AICPU threads from every completed
+    // task's start_time and end_time; the host folds them into its table
+    // afterwards (fold_func_samples()).
+    FuncCost cost_model[RUNTIME_MAX_FUNC_ID];
+    FuncSamples func_samples[RUNTIME_MAX_FUNC_ID];
+
+    // Resolved queue: tasks made ready by AICores (resolve_on_aicore). Every
+    // task is readied at most once per launch, so the slot array (one per
+    // task, allocated by finalize_graph()) never wraps. A core reserves a
+    // slot with fetch_add on resolved_tail and stores task_id + 1 into it;
+    // AICPU threads claim published (non-zero) slots in order by advancing
+    // resolved_head with a CAS. The AICPU clears the queue at every launch.
+    // The host rewrites resolved_ids to a device buffer on real devices.
+    std::atomic<int>* resolved_ids;
+    std::atomic<int> resolved_tail __attribute__((aligned(64)));
+    std::atomic<int> resolved_head __attribute__((aligned(64)));
+
+    // Completion doorbells. Every AICPU thread owns a contiguous run of
+    // words covering the core slots it may use (bit i of the run = its i-th
+    // slot, see thread_doorbell_base()); a core rings its bit after bumping
+    // done_count, so the thread only visits cores that finished something.
+    // Allocated by reserve_workers() and cleared by the AICPU at every
+    // launch. The host rewrites this pointer on real devices.
+    Doorbell* doorbells;
+    int doorbell_count;
+
+    // Task storage: task i lives in task_chunks[i >> RUNTIME_TASK_CHUNK_SHIFT]
+    // at slot i & (RUNTIME_TASK_CHUNK_SIZE - 1). Chunks are allocated by
+    // add_task() as needed. On real devices the host uploads all chunks as
+    // one block and rewrites this table to point into it.
+    TaskChunk* task_chunks[RUNTIME_MAX_TASK_CHUNKS];
+    int task_chunk_count;
 
 private:
-    // Task storage
-    Task tasks[RUNTIME_MAX_TASKS];  // Fixed-size task array
-    int next_task_id;               // Next available task ID
-
-    // Initial ready tasks (computed once, read-only after)
-    int initial_ready_tasks[RUNTIME_MAX_TASKS];
-    int initial_ready_count;
+    int next_task_id;          // Next available task ID
+    int finalized_task_count;  // Tasks covered by the last finalize_graph(), -1 if it failed
+    int worker_capacity;       // Handshakes allocated by reserve_workers()
+    int doorbell_capacity;     // Doorbell words allocated by reserve_workers()
 
   // Tensor pairs for host-device memory tracking
   TensorPair tensor_pairs[RUNTIME_MAX_TENSOR_PAIRS];
@@ -197,10 +539,15 @@ private:
 
 public:
     /**
-     * Constructor - zero-initialize all arrays
+     * Constructor - zero-initialize all arrays (no task chunks allocated)
      */
     Runtime();
 
+    /**
+     * Destructor - release task chunks and host-side edge storage
+     */
+    ~Runtime();
+
     // =========================================================================
     // Task Management
     // =========================================================================
@@ -211,34 +558,267 @@ public:
      * @param args      Array of uint64_t arguments
      * @param num_args  Number of arguments (must be <= RUNTIME_MAX_ARGS)
      * @param func_id   Function identifier
-     * @param core_type Core type for this task (0=AIC, 1=AIV)
-     * @return Task ID (>= 0) on success, -1 on failure
+     * @param core_type Core type for this task (0=AIC, 1=AIV, 2=MIX)
+     * @return Task ID (>= 0) on success, -1 on failure (too many tasks,
+     *         too many args or out of memory)
      */
     int add_task(uint64_t *args, int num_args, int func_id, int core_type = 0);
 
+    /**
+     * Allocate a new task and infer its dependencies from the device memory
+     * it reads and writes
+     *
+     * Against the tasks added earlier with declared regions, the new task
+     * gets an edge from the last writer of every byte it reads (RAW), from
+     * every reader since the last write of each byte it writes (WAR), and
+     * from the last writer of each byte it writes when nothing read it in
+     * between (WAW, otherwise implied through the readers). Only
+     * overlapping bytes create edges, and each producer is linked once.
+     * Tasks added without regions are not tracked; combine them with
+     * add_successor() as before.
+     *
+     * @param args         Array of uint64_t arguments
+     * @param num_args     Number of arguments (must be <= RUNTIME_MAX_ARGS)
+     * @param func_id      Function identifier
+     * @param core_type    Core type for this task (0=AIC, 1=AIV, 2=MIX)
+     * @param inputs       Regions the task reads (may be nullptr if none)
+     * @param num_inputs   Number of input regions
+     * @param outputs      Regions the task writes (may be nullptr if none)
+     * @param num_outputs  Number of output regions
+     * @return Task ID (>= 0) on success, -1 on failure (no task is added)
+     */
+    int add_task(uint64_t *args, int num_args, int func_id, int core_type,
+        const TensorRegion* inputs, int num_inputs, const TensorRegion* outputs, int num_outputs);
+
     /**
      * Add a dependency edge: from_task -> to_task
      *
-     * This adds to_task to from_task's fanout array and increments
-     * to_task's fanin counter.
+     * This records the edge, grows from_task's fanout count and increments
+     * to_task's fanin counter. There is no per-task successor limit; the
+     * edge is placed in the packed fanout array by finalize_graph().
      *
      * @param from_task  Producer task ID
      * @param to_task    Consumer task ID (depends on from_task)
      */
     void add_successor(int from_task, int to_task);
 
+    /**
+     * Pack all recorded successor lists into the contiguous fanout_edges
+     * array (CSR), assign each task its fanout_offset and capture the
+     * fanin snapshot used to replay the graph.
+     *
+     * Must be called after the graph is built and before execution.
+     * Calling it again is a no-op unless tasks or edges were added since.
+     *
+     * @return 0 on success, -1 on allocation failure
+     */
+    int finalize_graph();
+
+    /**
+     * Set the estimated cost of a kernel for rank computation.
+     *
+     * Ranks weight each task by its kernel's cost; kernels without an
+     * estimate take their measured cost from the cost model, or 1 if they
+     * were never measured, so without either a task's rank is the length
+     * of the longest chain it heads. Call before finalize_graph(). Use
+     * device timer ticks to combine estimates with measured costs.
+     *
+     * @param func_id  Function identifier
+     * @param cost     Estimated cost in any consistent unit (>= 1)
+     * @return 0 on success, -1 on invalid arguments or out of memory
+     */
+    int set_func_cost(int func_id, int cost);
+
+    /**
+     * Measured cost estimate of a kernel from the online cost model
+     *
+     * @param func_id  Function identifier
+     * @param stddev   Receives the standard deviation (may be nullptr)
+     * @return Mean duration in device timer ticks, 0 if never measured
+     */
+    double func_estimate(int func_id, double* stddev = nullptr) const;
+
+    /**
+     * Rank cost of a kernel: its set_func_cost() estimate if given, else
+     * its measured mean duration (at least 1) if any, else 1
+     *
+     * @param func_id  Function identifier
+     * @return Cost used by the upward ranks
+     */
+    int rank_cost(int func_id) const;
+
+    /**
+     * Install the host's cost model estimates (host only)
+     *
+     * Once the graph is finalized, the task ranks are recomputed if the
+     * rank cost of any measured kernel moved by more than an eighth since
+     * they were last computed, so priorities follow the measurements
+     * without recomputing on every small change.
+     *
+     * @param model  RUNTIME_MAX_FUNC_ID estimates indexed by func_id
+     * @return 1 if task_ranks changed, 0 if not, -1 on allocation failure
+     */
+    int apply_cost_model(const FuncCost* model);
+
+    /**
+     * Fold the durations measured by the last launch (func_samples) into a
+     * cost model (host only)
+     *
+     * A launch that ran n tasks of a kernel moves its moving averages as n
+     * measurements at the launch's mean would: the old estimate keeps
+     * weight (1 - RUNTIME_COST_EWMA_ALPHA)^n, and the variance also takes
+     * the launch's own spread. A kernel's first launch sets its estimate.
+     *
+     * @param model  RUNTIME_MAX_FUNC_ID estimates indexed by func_id
+     */
+    void fold_func_samples(FuncCost* model) const;
+
+    /**
+     * Enable or disable the hand-written edge report.
+     *
+     * When enabled, finalize_graph() runs report_unneeded_edges() so
+     * orchestration that declares tensor regions can find the
+     * add_successor() calls it no longer needs.
+     *
+     * @param enable  true to report at finalize_graph()
+     */
+    void set_edge_report(bool enable) { edge_report = enable; }
+
+    /**
+     * Print every hand-written edge between two tasks with declared regions
+     * that inference shows is unnecessary: either the inferred edges
+     * already order the two tasks, or there is no data dependency between
+     * them (they touch no common bytes, or both only read them).
+     *
+     * @return Number of unnecessary hand-written edges
+     */
+    int report_unneeded_edges() const;
+
+    /**
+     * Restore every task's fanin from the snapshot taken by
+     * finalize_graph(), undoing the decrements of a previous execution.
+     * Called by the scheduler at the start of each launch.
+     */
+    void reset_fanin();
+
+    /**
+     * Empty the resolved queue. Called by the scheduler at the start of
+     * each launch, before any AICore can publish to it.
+     */
+    void reset_resolved();
+
+    /**
+     * Publish a task made ready on an AICore to the resolved queue
+     * (resolve_on_aicore mode)
+     *
+     * @param task_id  Task whose fanin just reached zero
+     */
+    void publish_resolved(int task_id) {
+        int slot = resolved_tail.fetch_add(1, std::memory_order_relaxed);
+        resolved_ids[slot].store(task_id + 1, std::memory_order_release);
+    }
+
+    /**
+     * Claim up to max_tasks published tasks from the resolved queue in
+     * order. Safe to call from several scheduler threads at once; a slot
+     * that is reserved but not yet published ends the claim.
+     *
+     * @param task_ids   Receives the claimed task IDs
+     * @param max_tasks  Capacity of task_ids
+     * @return Number of tasks claimed (0 if none are published)
+     */
+    int claim_resolved(int* task_ids, int max_tasks);
+
+    /**
+     * Report a completion to the AICPU thread managing a core
+     *
+     * @param word  Handshake::doorbell_word of the core
+     * @param mask  Handshake::doorbell_mask of the core
+     */
+    void ring_doorbell(uint32_t word, uint64_t mask) {
+        doorbells[word].bits.fetch_or(mask, std::memory_order_release);
+    }
+
+    // =========================================================================
+    // Launch Topology
+    // =========================================================================
+
+    /**
+     * Size the handshake and doorbell storage for a launch (host only)
+     *
+     * Uses block_dim, sche_cpu_num and rebalance_cores, which must already
+     * be set for the launch. The storage only grows, so replays and smaller
+     * launches keep it. Every handshake and doorbell starts zeroed.
+     *
+     * @param count  Number of workers (AICores) of the launch
+     * @return 0 on success, -1 on invalid topology or allocation failure
+     */
+    int reserve_workers(int count);
+
+    /**
+     * First block dealt to an AICPU thread. Thread t gets blocks
+     * [thread_first_block(t), thread_first_block(t + 1)), so the threads'
+     * shares differ by at most one block.
+     */
+    int thread_first_block(int thread_idx) const { return thread_idx * block_dim / sche_cpu_num; }
+
+    /**
+     * Core slots an AICPU thread may use: the cores of its own blocks, or
+     * every core when blocks can move between threads (rebalance_cores)
+     */
+    int thread_slot_capacity(int thread_idx) const {
+        if (rebalance_cores != 0 && sche_cpu_num > 1) {
+            return worker_count;
+        }
+        int cores_per_block = block_dim > 0 ? worker_count / block_dim : 0;
+        return cores_per_block * (thread_first_block(thread_idx + 1) - thread_first_block(thread_idx));
+    }
+
+    /**
+     * First doorbell word of an AICPU thread's run (one bit per slot);
+     * thread_doorbell_base(sche_cpu_num) is the number of words in use
+     */
+    int thread_doorbell_base(int thread_idx) const {
+        int base = 0;
+        for (int t = 0; t < thread_idx; t++) {
+            base += (thread_slot_capacity(t) + 63) / 64;
+        }
+        return base;
+    }
+
     // =========================================================================
     // Query Methods
     // =========================================================================
 
     /**
-     * Get a pointer to a task by ID
+     * Get a pointer to a task payload by ID
      *
      * @param task_id  Task ID to query
      * @return Pointer to task, or nullptr if invalid ID
      */
     Task *get_task(int task_id);
 
+    /**
+     * Get a task payload by ID without bounds checking
+     *
+     * @param task_id  Task ID in [0, get_task_count())
+     * @return Pointer to task payload
+     */
+    Task *task_at(int task_id) const {
+        return &task_chunks[task_id >> RUNTIME_TASK_CHUNK_SHIFT]->tasks[task_id & (RUNTIME_TASK_CHUNK_SIZE - 1)];
+    }
+
+    /**
+     * Get a task's scheduling record by ID without bounds checking
+     * (scheduler hot path)
+     *
+     * @param task_id  Task ID in [0, get_task_count())
+     * @return Pointer to the task's TaskSched
+     */
+    TaskSched *sched_at(int task_id) const {
+        return &task_chunks[task_id >> RUNTIME_TASK_CHUNK_SHIFT]->sched[task_id & (RUNTIME_TASK_CHUNK_SIZE - 1)];
+    }
+
     /**
      * Get the total number of tasks in the runtime
      *
@@ -246,6 +826,14 @@ public:
      */
     int get_task_count() const;
 
+    /**
+     * Get the successor IDs of a task (valid after finalize_graph())
+     *
+     * @param sched  Scheduling record of the task to query
+     * @return Pointer to sched->fanout_count successor task IDs
+     */
+    const int* get_fanout(const TaskSched* sched) const { return fanout_edges + sched->fanout_offset; }
+
     /**
      * Get initially ready tasks (fanin == 0) as entry point for execution
      *
@@ -253,8 +841,8 @@ public:
      * that have no dependencies (fanin == 0). The runtime can use this
      * as the starting point for task scheduling.
      *
-     * @param ready_tasks  Array to populate with ready task IDs (can be
-     * nullptr)
+     * @param ready_tasks  Array of at least get_task_count() entries to
+     * populate with ready task IDs (can be nullptr to only count)
      * @return Number of initially ready tasks
      */
     int get_initial_ready_tasks(int *ready_tasks);
@@ -302,6 +890,62 @@ public:
      */
     void clear_tensor_pairs();
 
+    // =========================================================================
+    // Graph Parameters (host-only)
+    // =========================================================================
+
+    /**
+     * Mark a task argument as part of a named parameter.
+     *
+     * Called by orchestration for every argument word that should follow
+     * the parameter when it is rebound with set_param(), e.g. each task's
+     * pointer to "input_a". A parameter may cover any number of words.
+     *
+     * @param name       Parameter name (shorter than RUNTIME_MAX_PARAM_NAME)
+     * @param task_id    Task whose argument is bound
+     * @param arg_index  Argument index in [0, task's num_args)
+     * @return 0 on success, -1 on invalid arguments or out of memory
+     */
+    int bind_param(const char* name, int task_id, int arg_index);
+
+    /**
+     * Rebind a named parameter: write value into every argument word bound
+     * to it and mark it dirty so the device copy is patched before the next
+     * replay. Cost is proportional to the words bound to this parameter.
+     *
+     * @param name   Parameter name given to bind_param()
+     * @param value  New argument value (typically a device pointer)
+     * @return Number of argument words patched, or -1 if name is unknown
+     */
+    int set_param(const char* name, uint64_t value);
+
+    /**
+     * Get the parameter table.
+     *
+     * @return Pointer to get_param_count() parameters
+     */
+    const RuntimeParam* get_params() const { return params; }
+
+    /**
+     * Get number of named parameters.
+     *
+     * @return Number of parameters
+     */
+    int get_param_count() const { return param_count; }
+
+    /**
+     * Get the parameter slot array indexed by RuntimeParam::first_slot and
+     * RuntimeParamSlot::next.
+     *
+     * @return Pointer to the slot array
+     */
+    const RuntimeParamSlot* get_param_slots() const { return param_slots; }
+
+    /**
+     * Mark every parameter clean after the device copy was updated.
+     */
+    void clear_param_dirty();
+
     // =========================================================================
     // Host API (host-only, not copied to device)
     // =========================================================================
@@ -309,6 +953,71 @@ public:
     // Host API function pointers for device memory operations
     // NOTE: Placed at end of class to avoid affecting device memory layout
     HostApi host_api;
+
+private:
+    // Edges recorded by add_successor(), packed by finalize_graph() (host-only)
+    RuntimeEdge* pending_edges;
+    int pending_edge_count;
+    int pending_edge_capacity;
+
+    // Named parameters and the argument words bound to them (host-only)
+    RuntimeParam* params;
+    int param_count;
+    int param_capacity;
+    RuntimeParamSlot* param_slots;
+    int param_slot_count;
+    int param_slot_capacity;
+
+    // Dependency inference state (host-only): interval map of last writers
+    // and readers, plus per-task bookkeeping indexed by task ID
+    RuntimeRegionSeg* region_segs;
+    int region_seg_count;
+    int region_seg_capacity;
+    RuntimeReaderNode* reader_nodes;
+    int reader_node_count;
+    int reader_node_capacity;
+    int* dep_marks;         // Last consumer each task was linked to, -1 if none
+    uint8_t* dep_declared;  // 1 if the task was added with regions
+    int dep_task_capacity;
+    bool edge_report;
+
+    // Estimated cost per func_id for rank computation, 0 where none was
+    // set (host-only)
+    int* func_costs;
+    int func_cost_count;
+
+    // Measured rank costs task_ranks was last computed with (host-only)
+    int rank_basis[RUNTIME_MAX_FUNC_ID];
+
+    // Counting-sort pending_edges by producer into edges/offsets
+    void pack_edges(int* edges, int* offsets) const;
+
+    // Fill ranks[] with upward ranks from the packed graph and fanin
+    // snapshot; returns false on allocation failure or a cycle
+    bool compute_ranks(int* ranks) const;
+
+    // Append an edge to pending_edges and update fanin/fanout counts
+    bool record_edge(int from_task, int to_task, int inferred);
+
+    // Link from_task -> to_task once per consumer (inference)
+    bool infer_edge(int from_task, int to_task);
+
+    // Cover the regions of a task about to be added and reserve what
+    // tracking them can need, so track_region() cannot fail afterwards
+    bool reserve_regions(const TensorRegion* inputs, int num_inputs, const TensorRegion* outputs, int num_outputs);
+
+    // Apply one read or write of [start, end) by task_id to the interval map
+    bool track_region(int task_id, uint64_t start, uint64_t end, bool write);
+
+    // Make segments cover [start, end) exactly; returns the first index and
+    // sets *last to one past the last, or -1 on allocation failure
+    int cover_region(uint64_t start, uint64_t end, int* last);
+
+    // Insert a segment at index, shifting later segments up
+    bool insert_region_seg(int index, uint64_t start, uint64_t end, int writer, int readers);
+
+    // Look up a parameter by name, -1 if absent
+    int find_param(const char* name) const;
 };
 
 #endif  // RUNTIME_H
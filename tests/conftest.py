@@ -0,0 +1,58 @@
+"""Shared helpers for the a2a3sim tests.
+
+Most sim tests drive an example script in a subprocess, usually the sim
+benchmark example, and check what it prints. The benchmark validates every
+run itself and reports it with one SUCCESS line.
+"""
+
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+PROJECT_ROOT = Path(__file__).parent.parent
+BENCH_EXAMPLE = PROJECT_ROOT / "examples" / "host_build_graph_sim_bench_example" / "main.py"
+
+
+requires_sim_toolchain = pytest.mark.skipif(
+    shutil.which("g++") is None or shutil.which("cmake") is None,
+    reason="g++ and cmake required to build the a2a3sim runtime",
+)
+
+
+def run_example(script, *args):
+    """Run an example script from its own directory; returns (returncode, stdout + stderr)."""
+    result = subprocess.run(
+        [sys.executable, str(script)] + [str(arg) for arg in args],
+        cwd=Path(script).parent,
+        capture_output=True,
+        text=True,
+        timeout=600,
+    )
+    return result.returncode, result.stdout + result.stderr
+
+
+def run_bench(*args):
+    """Run the sim benchmark example; returns (returncode, stdout + stderr)."""
+    return run_example(BENCH_EXAMPLE, *args)
+
+
+def assert_tasks_ran(rc, output, tasks, runs=None, graphs=None):
+    """Check that the benchmark succeeded and validated every task of every run."""
+    assert rc == 0, output[-4000:]
+    expected = f"SUCCESS: All {tasks} tasks ran once and in dependency order"
+    if runs is not None:
+        expected += f" in each of {runs} runs"
+    if graphs is not None:
+        expected += f" of each of {graphs} graphs"
+    assert expected in output, output[-4000:]
+
+
+def bench_checksum(name, output):
+    """The hex "<name> checksum" the benchmark printed, e.g. name="Tile"."""
+    match = re.search(name + r" checksum: ([0-9a-f]+)", output)
+    assert match is not None, output[-4000:]
+    return match.group(1)
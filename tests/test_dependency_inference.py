@@ -0,0 +1,119 @@
+"""Tests for dependency inference from declared tensor regions.
+
+Builds a small host program against runtime.cpp that adds tasks with the
+regions they read and write, plus a few hand-written edges, and prints the
+packed graph and the report of unneeded hand-written edges. The regions
+cover RAW, WAR and WAW hazards, partial overlaps and disjoint tensors.
+"""
+
+import shutil
+import subprocess
+
+import pytest
+
+from conftest import PROJECT_ROOT
+
+RUNTIME_DIR = PROJECT_ROOT / "src" / "runtime" / "host_build_graph" / "runtime"
+SIM_PLATFORM = PROJECT_ROOT / "src" / "platform" / "a2a3sim"
+
+HARNESS = r"""
+#include <cstdio>
+
+#include "runtime.h"
+
+static char x[64];
+static char y[64];
+
+static int add(Runtime* r, TensorRegion* in, int num_in, TensorRegion* out, int num_out) {
+    uint64_t args[1] = {0};
+    return r->add_task(args, 1, 0, 0, in, num_in, out, num_out);
+}
+
+int main() {
+    Runtime* r = new Runtime();
+    TensorRegion x_all = {x, 64};
+    TensorRegion x_lo = {x, 32};
+    TensorRegion x_hi = {x + 32, 32};
+    TensorRegion x_head = {x, 16};
+    TensorRegion x_tail = {x + 48, 16};
+    TensorRegion x_mid = {x + 8, 48};
+    TensorRegion x_first = {x, 8};
+    TensorRegion y_all = {y, 64};
+    TensorRegion y_lo = {y, 32};
+
+    add(r, nullptr, 0, &x_all, 1);     // T0 writes x
+    add(r, &x_lo, 1, nullptr, 0);      // T1 reads x[0, 32)     RAW 0
+    add(r, &x_hi, 1, nullptr, 0);      // T2 reads x[32, 64)    RAW 0
+    add(r, nullptr, 0, &x_all, 1);     // T3 writes x           WAR 1, 2 (WAW 0 implied)
+    add(r, nullptr, 0, &x_head, 1);    // T4 writes x[0, 16)    WAW 3
+    add(r, &y_all, 1, nullptr, 0);     // T5 reads y            none
+    add(r, &x_tail, 1, nullptr, 0);    // T6 reads x[48, 64)    RAW 3
+    add(r, &x_mid, 1, nullptr, 0);     // T7 reads x[8, 56)     RAW 4, 3
+    add(r, &x_first, 1, &y_lo, 1);     // T8 reads x[0, 8), writes y[0, 32)  RAW 4, WAR 5
+    uint64_t args[1] = {0};
+    r->add_task(args, 1, 0, 0);        // T9 without regions
+
+    r->add_successor(0, 3);            // implied through T1
+    r->add_successor(5, 6);            // disjoint tensors
+    r->add_successor(6, 7);            // both only read x[48, 56)
+    r->add_successor(8, 9);            // T9 is not tracked, not reported
+    r->set_edge_report(true);
+    if (r->finalize_graph() != 0) {
+        return 1;
+    }
+    for (int i = 0; i < r->get_task_count(); i++) {
+        const TaskSched* sched = r->sched_at(i);
+        const int* fanout = r->get_fanout(sched);
+        for (int j = 0; j < sched->fanout_count; j++) {
+            printf("edge %d %d\n", i, fanout[j]);
+        }
+    }
+    delete r;
+    return 0;
+}
+"""
+
+INFERRED = {(0, 1), (0, 2), (1, 3), (2, 3), (3, 4), (3, 6), (3, 7), (4, 7), (4, 8), (5, 8)}
+HAND_WRITTEN = {(0, 3), (5, 6), (6, 7), (8, 9)}
+
+
+@pytest.fixture(scope="module")
+def harness_output(tmp_path_factory):
+    build_dir = tmp_path_factory.mktemp("inference")
+    source = build_dir / "harness.cpp"
+    source.write_text(HARNESS)
+    binary = build_dir / "harness"
+    subprocess.run(
+        [
+            "g++", "-std=c++17", "-O1",
+            f"-I{RUNTIME_DIR}", f"-I{SIM_PLATFORM / 'host'}", f"-I{SIM_PLATFORM / 'common'}",
+            f"-I{PROJECT_ROOT / 'src' / 'platform' / 'include'}",
+            str(source), str(RUNTIME_DIR / "runtime.cpp"), "-o", str(binary), "-lpthread",
+        ],
+        check=True,
+    )
+    result = subprocess.run([str(binary)], capture_output=True, text=True, timeout=60)
+    assert result.returncode == 0, result.stdout + result.stderr
+    return result.stdout
+
+
+@pytest.mark.skipif(shutil.which("g++") is None, reason="g++ required to build the inference harness")
+class TestDependencyInference:
+    """Edges follow RAW, WAR and WAW hazards on the overlapping bytes only."""
+
+    def test_inferred_edges(self, harness_output):
+        """The packed graph holds exactly the inferred and hand-written edges."""
+        edges = set()
+        for line in harness_output.splitlines():
+            if line.startswith("edge "):
+                _, a, b = line.split()
+                edges.add((int(a), int(b)))
+        assert edges == INFERRED | HAND_WRITTEN
+
+    def test_unneeded_edge_report(self, harness_output):
+        """Hand-written edges between tracked tasks are reported with the reason."""
+        assert "[Runtime] Unneeded edge 0 -> 3: implied by inferred dependencies" in harness_output
+        assert "[Runtime] Unneeded edge 5 -> 6: no data dependency" in harness_output
+        assert "[Runtime] Unneeded edge 6 -> 7: no data dependency" in harness_output
+        assert "Unneeded edge 8 -> 9" not in harness_output
+        assert "[Runtime] Hand-written edges: 4, unneeded: 3" in harness_output
@@ -0,0 +1,56 @@
+"""Tests for chain successors on a2a3sim.
+
+Runs the sim benchmark example on chain-shaped graphs with chaining on and
+off (--chain). With chaining on, a core runs a task's chain successor
+itself and the AICPU replays the completion; every AICPU thread logs how
+many tasks it saw complete that way, which must add up to the chainable
+tasks the example counts from the graph in every run. The runs combine
+chaining with deeper mailboxes and AICore-side resolution, which both
+change how completions reach the AICPU, and check that chaining leaves the
+output tiles unchanged.
+"""
+
+import re
+
+import pytest
+
+from conftest import assert_tasks_ran, bench_checksum, requires_sim_toolchain, run_bench
+
+TASKS = 300
+
+
+def run_chained(chain, *extra_args):
+    rc, output = run_bench(
+        "--tasks", TASKS,
+        "--shape", "unbalanced",
+        "--width", 6,
+        "--tile-kb", 1,
+        "--replays", 2,
+        "--chain", chain,
+        *extra_args,
+    )
+    assert_tasks_ran(rc, output, tasks=TASKS, runs=3)
+    counts = re.findall(r"\(\d+ stolen, (\d+) chained\)", output)
+    assert counts, output[-4000:]
+    return output, sum(int(n) for n in counts)
+
+
+@requires_sim_toolchain
+class TestSimChaining:
+    """Chain successors run on the finishing core and complete once."""
+
+    @pytest.mark.parametrize("extra_args", [
+        ["--mailbox-depth", "1"],
+        ["--mailbox-depth", "4", "--resolve", "aicore"],
+        ["--mailbox-depth", "2", "--resolve", "aicpu", "--block-dim", "2", "--threads", "2"],
+        ["--mailbox-depth", "4", "--resolve", "aicore", "--mix-ratio", "0.2", "--rebalance", "on"],
+    ])
+    def test_chain_matches_unchained(self, extra_args):
+        """Chaining runs tasks on the finishing core without changing the results."""
+        chained_output, chained = run_chained("on", *extra_args)
+        plain_output, unchained = run_chained("off", *extra_args)
+        expected = int(re.search(r"Chained:\s+(\d+) tasks", chained_output).group(1))
+        assert expected > 0
+        assert chained == 3 * expected
+        assert unchained == 0
+        assert bench_checksum("Tile", chained_output) == bench_checksum("Tile", plain_output)
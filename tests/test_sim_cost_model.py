@@ -0,0 +1,56 @@
+"""Tests for the online kernel cost model on a2a3sim.
+
+Runs the sim benchmark example with --cost-model, which saves the measured
+per-kernel durations after the run and seeds the next run from them. Every
+launch and replay measures each task once, so the sample counts grow by the
+number of tasks run, and a second run continues from the first one's table.
+"""
+
+import json
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+TASKS = 120
+REPLAYS = 1
+
+
+def run_cost_model(cost_path, extra_args=()):
+    rc, output = run_bench(
+        "--tasks", TASKS,
+        "--width", 8,
+        "--spin", 20000,
+        "--replays", REPLAYS,
+        "--policy", "critical_path",
+        "--cost-model", cost_path,
+        *extra_args,
+    )
+    assert_tasks_ran(rc, output, tasks=TASKS, runs=1 + REPLAYS)
+    return output, json.loads(cost_path.read_text())
+
+
+@requires_sim_toolchain
+class TestSimCostModel:
+    """Measured kernel durations are folded per func_id and persist."""
+
+    @pytest.mark.parametrize("extra_args", [
+        [],
+        ["--mix-ratio", "0.3"],
+    ])
+    def test_samples_accumulate_across_runs(self, tmp_path, extra_args):
+        """Each run measures every task once and continues the saved table."""
+        cost_path = tmp_path / "costs.json"
+        runs = 1 + REPLAYS
+
+        output, first = run_cost_model(cost_path, extra_args)
+        assert "Cost func 0:" in output
+        assert sum(entry[0] for entry in first.values()) == TASKS * runs
+        for samples, mean, var in first.values():
+            assert samples > 0
+            assert mean > 0
+            assert var >= 0
+
+        output, second = run_cost_model(cost_path, extra_args)
+        assert f"Cost model seeded from {cost_path}" in output
+        assert sum(entry[0] for entry in second.values()) == 2 * TASKS * runs
@@ -0,0 +1,50 @@
+"""Tests for the a2a3sim fiber backend.
+
+Runs the sim benchmark example with the simulated cores on their own
+threads and as fibers (set_core_backend()), and checks that both backends
+produce the same output tiles. The fiber runs use fewer host threads than
+cores, so fibers share host threads and switch at every handshake poll.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, bench_checksum, requires_sim_toolchain, run_bench
+
+
+def run_fibers_bench(*extra_args):
+    return run_bench("--tasks", 300, "--width", 8, "--tile-kb", 1, "--replays", 2, *extra_args)
+
+
+@requires_sim_toolchain
+class TestSimFibers:
+    """The fiber backend matches the thread backend."""
+
+    @pytest.mark.parametrize("extra_args", [
+        ["--block-dim", "4", "--threads", "2"],
+        ["--block-dim", "2", "--threads", "2", "--mix-ratio", "0.3"],
+        ["--block-dim", "2", "--threads", "2", "--mailbox-depth", "4", "--resolve", "aicore", "--idle-wait", "spin"],
+        ["--block-dim", "2", "--threads", "1", "--mix-ratio", "0.3", "--graphs", "2", "--idle-wait", "yield"],
+        ["--block-dim", "16", "--threads", "3", "--rebalance", "on"],
+    ])
+    def test_same_tiles_as_threads(self, extra_args):
+        """All tasks complete on both backends with identical output tiles."""
+        checksums = []
+        for backend in ("threads", "fibers"):
+            rc, output = run_fibers_bench("--core-backend", backend, "--host-threads", "3", *extra_args)
+            assert_tasks_ran(rc, output, tasks=300, runs=3)
+            assert f"{backend} backend" in output
+            checksums.append(bench_checksum("Tile", output))
+        assert checksums[0] == checksums[1]
+
+    def test_single_fiber_thread(self):
+        """One host thread runs every core of a launch without MIX tasks."""
+        rc, output = run_fibers_bench("--block-dim", "4", "--core-backend", "fibers", "--host-threads", "1")
+        assert_tasks_ran(rc, output, tasks=300, runs=3)
+        assert "AICore fiber(s) on 1 thread(s)" in output
+
+    def test_mix_needs_three_fiber_threads(self):
+        """MIX gangs are rejected when their cores would share a host thread."""
+        rc, output = run_fibers_bench("--block-dim", "2", "--threads", "2", "--mix-ratio", "0.3",
+                                      "--core-backend", "fibers", "--host-threads", "2")
+        assert rc != 0
+        assert "MIX tasks need at least 3 fiber host threads" in output
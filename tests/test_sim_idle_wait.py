@@ -0,0 +1,30 @@
+"""Tests for the a2a3sim idle wait modes.
+
+Runs the sim benchmark example under each set_idle_wait() mode. Block mode
+puts idle simulated cores and AICPU threads to sleep on futexes, so these
+runs also check that every write they wait on wakes them: a lost wake
+shows up as a timeout or as tasks that never ran.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+
+@requires_sim_toolchain
+class TestSimIdleWait:
+    """Every idle wait mode runs each task once and in order."""
+
+    @pytest.mark.parametrize("mode,extra_args", [
+        ("spin", ["--block-dim", "1", "--threads", "1"]),
+        ("yield", ["--block-dim", "2", "--threads", "2"]),
+        ("block", ["--block-dim", "4", "--threads", "3", "--rebalance", "on"]),
+        ("block", ["--block-dim", "2", "--threads", "2", "--mailbox-depth", "4", "--resolve", "aicore"]),
+        ("block", ["--block-dim", "2", "--threads", "1", "--mix-ratio", "0.3", "--graphs", "2"]),
+        ("block", ["--block-dim", "2", "--threads", "2", "--idle-spin", "0", "--idle-yield", "0"]),
+    ])
+    def test_idle_wait_mode(self, mode, extra_args):
+        """All tasks complete in every launch and replay."""
+        rc, output = run_bench("--tasks", 200, "--width", 8, "--replays", 2, "--idle-wait", mode, *extra_args)
+        assert_tasks_ran(rc, output, tasks=200, runs=3)
+        assert f"{mode} idle wait" in output
@@ -0,0 +1,26 @@
+"""Tests for gang-scheduled MIX tasks on a2a3sim.
+
+Runs the sim benchmark example with a share of MIX tasks, which run the
+gang stamp kernel on the AIC and both AIVs of a block together. The kernel
+only stamps a task when all three roles met at the block barrier, and the
+example validates that every task ran exactly once and in dependency order.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+
+@requires_sim_toolchain
+class TestSimMixTasks:
+    """MIX tasks are posted to a whole block at once and complete once."""
+
+    @pytest.mark.parametrize("extra_args", [
+        ["--mailbox-depth", "1"],
+        ["--mailbox-depth", "4", "--resolve", "aicore"],
+        ["--block-dim", "5", "--threads", "2", "--rebalance", "on", "--placement", "locality"],
+    ])
+    def test_mixed_graph(self, extra_args):
+        """AIC, AIV and MIX tasks together run once and in order."""
+        rc, output = run_bench("--tasks", 200, "--width", 16, "--mix-ratio", 0.3, *extra_args)
+        assert_tasks_ran(rc, output, tasks=200)
@@ -0,0 +1,40 @@
+"""Tests for concurrent multi-graph execution on a2a3sim.
+
+Runs the sim benchmark example with several copies of its graph, each in its
+own runtime, launched together on disjoint core partitions and replayed the
+same way. Each partition is scheduled by its own AICPU executor instance,
+and the example validates every run of every graph separately.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+
+@requires_sim_toolchain
+class TestSimMultiGraph:
+    """Graphs in flight on disjoint partitions each run once and in order."""
+
+    @pytest.mark.parametrize("graphs,extra_args", [
+        (4, ["--block-dim", "1", "--threads", "1"]),
+        (3, ["--block-dim", "2", "--threads", "2", "--mailbox-depth", "4", "--resolve", "aicore"]),
+        (2, ["--block-dim", "2", "--threads", "1", "--mix-ratio", "0.3", "--policy", "critical_path"]),
+    ])
+    def test_concurrent_graphs(self, graphs, extra_args):
+        """Every graph completes in every launch and replay."""
+        rc, output = run_bench("--tasks", 150, "--width", 8, "--graphs", graphs, "--replays", 1, *extra_args)
+        assert_tasks_ran(rc, output, tasks=150, runs=2, graphs=graphs)
+        assert f"Partitions:  {graphs} graphs in flight" in output
+        for partition in range(graphs):
+            assert f"Starting AICPU kernel execution on partition {partition}" in output
+
+    def test_failed_partition_reported(self):
+        """wait_runtime() fails for a graph whose AICPU timed out."""
+        # Each kernel holds its core far longer than the spinning AICPU's
+        # idle timeout
+        rc, output = run_bench("--tasks", 2, "--width", 1, "--graphs", 2, "--block-dim", 1, "--threads", 1,
+                               "--idle-wait", "spin", "--work-us", 8000000)
+        assert rc != 0
+        assert "Timeout after" in output
+        assert "Error: AICPU execution failed on partition 0" in output
+        assert "SUCCESS" not in output
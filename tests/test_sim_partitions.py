@@ -0,0 +1,41 @@
+"""Tests for uneven block partitions and core rebalancing on a2a3sim.
+
+Runs the sim benchmark example with block counts that the AICPU thread
+count does not divide, with and without dynamic core rebalancing, and with
+more scheduler threads than the old fixed limit, flat and grouped. The
+example validates that every task ran exactly once and in dependency order.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+
+def run_partitioned(block_dim, threads, rebalance, group_size=0):
+    return run_bench(
+        "--tasks", 200,
+        "--width", 16,
+        "--block-dim", block_dim,
+        "--threads", threads,
+        "--rebalance", rebalance,
+        "--group-size", group_size,
+    )
+
+
+@requires_sim_toolchain
+class TestSimPartitions:
+    """block_dim need not be a multiple of the AICPU thread count."""
+
+    @pytest.mark.parametrize("block_dim,threads", [(5, 2), (7, 3), (23, 4)])
+    @pytest.mark.parametrize("rebalance", ["off", "on"])
+    def test_odd_block_counts(self, block_dim, threads, rebalance):
+        """Every task runs once and in order for an uneven partition."""
+        assert_tasks_ran(*run_partitioned(block_dim, threads, rebalance), tasks=200)
+
+    @pytest.mark.parametrize("block_dim,threads,group_size,rebalance", [
+        (10, 8, 0, "off"),
+        (16, 16, 4, "on"),
+    ])
+    def test_many_threads(self, block_dim, threads, group_size, rebalance):
+        """Thread and core storage is sized per launch, with or without coordinator groups."""
+        assert_tasks_ran(*run_partitioned(block_dim, threads, rebalance, group_size), tasks=200)
@@ -0,0 +1,106 @@
+"""Tests for priority dispatch order on a2a3sim.
+
+Runs the sim benchmark example on one AIC core with chaining off, so tasks
+run one at a time in the order the AICPU dispatches them, and checks the
+saved start stamps against the policy: every task started must be on the
+highest ready queue level among the tasks ready at that moment. Levels are
+the policy priority (upward rank for critical path, depth from a source
+for LIFO) quantized onto the 32 levels of the ready queue.
+"""
+
+import json
+
+import numpy as np
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+TASKS = 80
+READY_LEVELS = 32
+
+
+def run_serial(tmp_path, *extra_args):
+    stamps_path = tmp_path / "stamps.npz"
+    rc, output = run_bench(
+        "--tasks", TASKS,
+        "--shape", "random",
+        "--width", 12,
+        "--fanin", 2,
+        "--block-dim", 1,
+        "--threads", 1,
+        "--aic-ratio", 1.0,
+        "--chain", "off",
+        "--stamps-out", stamps_path,
+        *extra_args,
+    )
+    assert_tasks_ran(rc, output, tasks=TASKS)
+    saved = np.load(stamps_path)
+    return saved["stamps"], saved["edges"]
+
+
+def priorities(edges, kind):
+    """Upward rank (unit costs) or depth from a source of every task."""
+    succs = [[] for _ in range(TASKS)]
+    preds = [[] for _ in range(TASKS)]
+    for a, b in edges:
+        succs[a].append(b)
+        preds[b].append(a)
+    remaining = [len(p) for p in preds]
+    order = [t for t in range(TASKS) if remaining[t] == 0]
+    depth = [0] * TASKS
+    for t in order:
+        for s in succs[t]:
+            depth[s] = max(depth[s], depth[t] + 1)
+            remaining[s] -= 1
+            if remaining[s] == 0:
+                order.append(s)
+    if kind == "depth":
+        return depth, preds
+    rank = [0] * TASKS
+    for t in reversed(order):
+        rank[t] = 1 + max((rank[s] for s in succs[t]), default=0)
+    return rank, preds
+
+
+def out_of_order_starts(stamps, edges, kind):
+    """Tasks started while a task on a higher ready queue level was ready."""
+    prio, preds = priorities(edges, kind)
+    top = max(prio)
+    level = [p * READY_LEVELS // (top + 1) for p in prio]
+    started = set()
+    violations = 0
+    for task in np.argsort(stamps):
+        ready = [t for t in range(TASKS) if t not in started and all(p in started for p in preds[t])]
+        if level[task] < max(level[t] for t in ready):
+            violations += 1
+        started.add(int(task))
+    return violations
+
+
+@requires_sim_toolchain
+class TestSimSchedule:
+    """Ready tasks are dispatched highest priority first."""
+
+    @pytest.mark.parametrize("extra_args,kind", [
+        (["--policy", "graph", "--schedule", "rank"], "rank"),
+        (["--policy", "critical_path"], "rank"),
+        (["--policy", "lifo"], "depth"),
+    ])
+    def test_priority_order(self, tmp_path, extra_args, kind):
+        """Each dispatch takes a task of the highest ready level."""
+        stamps, edges = run_serial(tmp_path, *extra_args)
+        assert out_of_order_starts(stamps, edges, kind) == 0
+
+    def test_large_costs_keep_rank_order(self, tmp_path):
+        """Seeded costs whose path sums pass INT32_MAX still dispatch by rank."""
+        # 1 s per kernel in ns timer ticks: every path of 3+ tasks exceeds
+        # INT32_MAX before the ranks are scaled down
+        cost_path = tmp_path / "costs.json"
+        cost_path.write_text(json.dumps({str(f): [1, 1e9, 0.0] for f in range(3)}))
+        stamps, edges = run_serial(tmp_path, "--policy", "critical_path", "--cost-model", cost_path)
+        assert out_of_order_starts(stamps, edges, "rank") == 0
+
+    def test_fifo_ignores_rank(self, tmp_path):
+        """Arrival order breaks rank order on the same graph, so the check above is not vacuous."""
+        stamps, edges = run_serial(tmp_path, "--policy", "graph", "--schedule", "fifo")
+        assert out_of_order_starts(stamps, edges, "rank") > 0
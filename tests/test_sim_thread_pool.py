@@ -0,0 +1,31 @@
+"""Tests for the persistent a2a3sim worker thread pool.
+
+Runs the sim benchmark example on a small graph replayed many times. Only
+the first launch starts pool threads; every replay reuses the parked AICPU
+and AICore threads, and the example validates each run separately.
+"""
+
+import pytest
+
+from conftest import assert_tasks_ran, requires_sim_toolchain, run_bench
+
+
+@requires_sim_toolchain
+class TestSimThreadPool:
+    """Replays run on the pool threads started by the first launch."""
+
+    @pytest.mark.parametrize("block_dim,threads", [(1, 1), (2, 2)])
+    def test_replays_reuse_pool(self, block_dim, threads):
+        """Every replay completes without starting a thread."""
+        replays = 200
+        rc, output = run_bench(
+            "--tasks", 4,
+            "--width", 2,
+            "--block-dim", block_dim,
+            "--threads", threads,
+            "--replays", replays,
+        )
+        assert_tasks_ran(rc, output, tasks=4, runs=replays + 1)
+        pool_size = threads + 3 * block_dim
+        assert output.count(f"({pool_size} new pool thread(s))") == 1
+        assert output.count("(0 new pool thread(s))") == replays
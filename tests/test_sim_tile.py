@@ -0,0 +1,59 @@
+"""Tests for the a2a3sim vector tile helpers (sim_tile.h).
+
+Compiles the sim example kernels for every ISA the host runs and checks
+that they stay self-contained: no relocations against .text, no constant
+pools and no out-of-line functions in the object. The throughput benchmark
+checks each kernel against NumPy; it runs on sizes that leave a vector tail.
+"""
+
+import shutil
+import subprocess
+import sys
+
+import pytest
+
+from conftest import PROJECT_ROOT, run_example
+
+SIM_EXAMPLE = PROJECT_ROOT / "examples" / "host_build_graph_sim_example"
+THROUGHPUT = SIM_EXAMPLE / "kernel_throughput.py"
+KERNEL_DIR = SIM_EXAMPLE / "kernels" / "aiv"
+
+sys.path.insert(0, str(PROJECT_ROOT / "python"))
+
+from pto_compiler import PTOCompiler, host_sim_isas  # noqa: E402
+
+
+requires_gxx = pytest.mark.skipif(shutil.which("g++") is None, reason="g++ required to compile sim kernels")
+
+
+def section_names(obj_path):
+    result = subprocess.run(["readelf", "-SW", str(obj_path)], capture_output=True, text=True, check=True)
+    return [line.split("]", 1)[1].split()[0] for line in result.stdout.splitlines() if "] ." in line]
+
+
+@requires_gxx
+@pytest.mark.skipif(shutil.which("readelf") is None, reason="readelf required")
+@pytest.mark.parametrize("isa", host_sim_isas())
+def test_kernels_self_contained(isa, tmp_path):
+    compiler = PTOCompiler(platform="a2a3sim")
+    for source in sorted(KERNEL_DIR.glob("*.cpp")):
+        obj = tmp_path / f"{source.stem}.o"
+        obj.write_bytes(compiler.compile_incore_sim(str(source), isa=isa))
+        names = section_names(obj)
+        assert ".text" in names
+        assert not [n for n in names if n.startswith((".rela.text", ".rodata", ".text."))], (source.name, names)
+
+
+def test_unknown_isa_rejected():
+    with pytest.raises(ValueError):
+        PTOCompiler(platform="a2a3sim").compile_incore_sim(str(KERNEL_DIR / "kernel_add.cpp"), isa="mmx")
+
+
+@requires_gxx
+@pytest.mark.parametrize("elements", [1, 37, 4099])
+def test_throughput_results_match_numpy(elements):
+    rc, output = run_example(THROUGHPUT, "--elements", elements, "--repeats", 2)
+    assert rc == 0, output
+    assert "Kernel Throughput in GB/s" in output
+    for name in ("kernel_add", "kernel_mul", "kernel_add_scalar"):
+        assert name in output